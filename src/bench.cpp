@@ -0,0 +1,659 @@
+// bench.cpp
+// Standalone throughput benchmarks for the CPU-side maze code (no GL needed).
+//
+// Build: g++ -O2 -std=c++17 -I.. -pthread bench.cpp collision.cpp crowd.cpp culling.cpp flowfield.cpp generator.cpp hpa.cpp maze_grid.cpp profiler.cpp pvs.cpp software_raster.cpp solver.cpp visibility.cpp wall_mesh.cpp worker_pool.cpp -o bench
+// Run:   ./bench            run every suite
+//        ./bench generate   run only the named suite
+#include "collision.h"
+#include "crowd.h"
+#include "culling.h"
+#include "flowfield.h"
+#include "generator.h"
+#include "hpa.h"
+#include "maze_grid.h"
+#include "pvs.h"
+#include "software_raster.h"
+#include "solver.h"
+#include "visibility.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+using Clock = std::chrono::high_resolution_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// --- Generators: rooms carved per second ---
+static void benchGenerate() {
+    const MazeAlgorithm algorithms[] = { MazeAlgorithm::Backtracker, MazeAlgorithm::Kruskal,
+                                         MazeAlgorithm::Wilson, MazeAlgorithm::Prim };
+    const int sizes[] = { 64, 512, 2048 };
+
+    printf("%-12s %10s %12s %10s %14s\n", "algorithm", "rooms", "grid", "ms", "rooms/s");
+    for (MazeAlgorithm algorithm : algorithms) {
+        for (int size : sizes) {
+            Maze m;
+            auto start = Clock::now();
+            generateMaze(m, size, size, algorithm, 1234);
+            double seconds = secondsSince(start);
+
+            double rooms = double(size) * size;
+            char grid[32];
+            snprintf(grid, sizeof(grid), "%dx%d", m.width(), m.height());
+            printf("%-12s %10.0f %12s %10.2f %14.0f\n", algorithmName(algorithm), rooms, grid,
+                   seconds * 1000.0, rooms / seconds);
+        }
+    }
+
+    // Eller streams rows through a fixed 64-row window, as the endless mode does
+    for (int size : sizes) {
+        EllerGenerator eller(size, 1234);
+        Maze window(eller.gridWidth(), 64, true);
+        auto start = Clock::now();
+        for (long long row = 0; row < 2LL * size + 1; ++row) {
+            int slot = static_cast<int>(row % 64);
+            eller.nextRow(window, slot);
+        }
+        double seconds = secondsSince(start);
+
+        double rooms = double(size) * size;
+        char grid[32];
+        snprintf(grid, sizeof(grid), "%dx%d", window.width(), 2 * size + 1);
+        printf("%-12s %10.0f %12s %10.2f %14.0f\n", "eller", rooms, grid, seconds * 1000.0, rooms / seconds);
+    }
+}
+
+// --- Frustum culling: boxes tested per second ---
+static void benchCull() {
+    glm::mat4 projection = glm::perspective(glm::radians(65.0f), 800.0f / 600.0f, 0.1f, 300.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(512.0f, 4.0f, -512.0f), glm::vec3(512.0f, 4.0f, -513.0f),
+                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    Frustum frustum = extractFrustum(projection * view);
+
+    // One box per wall cell of a 256x256 grid, the worst case for per-cell culling
+    BoxList boxes;
+    for (int r = 0; r < 256; ++r)
+        for (int c = 0; c < 256; ++c)
+            boxes.add(glm::vec3(c * 4.0f, 0.0f, -(r + 1) * 4.0f), glm::vec3((c + 1) * 4.0f, 40.0f, -r * 4.0f));
+    std::vector<uint8_t> visible(boxes.size());
+
+    const int passes = 200;
+    std::size_t drawn = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < passes; ++i)
+        drawn = cullBoxes(frustum, boxes, visible.data());
+    double seconds = secondsSince(start);
+
+    printf("%zu boxes, %zu visible, %.3f ms/pass, %.0f boxes/s\n", boxes.size(), drawn,
+           seconds * 1000.0 / passes, boxes.size() * passes / seconds);
+}
+
+// --- Grid-DDA visibility: cost per frame and walls rejected ---
+static void benchVisibility() {
+    const float spacing = 4.0f, viewDistance = 300.0f;
+    const float fov = 2.0f * std::atan(std::tan(glm::radians(65.0f) / 2.0f) * 800.0f / 600.0f);
+    Maze m;
+    generateMaze(m, 256, 256, MazeAlgorithm::Backtracker, 7);
+
+    // Walk the camera through open rooms looking along -Z
+    GridVisibility visibility;
+    const int frames = 1000;
+    long long seen = 0, inRange = 0;
+    auto start = Clock::now();
+    for (int f = 0; f < frames; ++f) {
+        int row = 1 + 2 * ((f * 7) % 256), col = 1 + 2 * ((f * 13) % 256);
+        float camX = (col + 0.5f) * spacing, camZ = -(row + 0.5f) * spacing;
+        visibility.compute(m, spacing, camX, camZ, 0.0f, -1.0f, fov, viewDistance);
+        seen += visibility.visibleWallCells();
+    }
+    double seconds = secondsSince(start);
+
+    // Walls inside the view wedge that frustum culling alone would keep
+    for (int f = 0; f < frames; f += 50) {
+        int row = 1 + 2 * ((f * 7) % 256), col = 1 + 2 * ((f * 13) % 256);
+        int reach = static_cast<int>(viewDistance / spacing);
+        for (int r = row; r <= row + reach; ++r)
+            for (int c = col - reach; c <= col + reach; ++c) {
+                float dx = float(c - col), dy = float(r - row);
+                if (dx * dx + dy * dy > float(reach) * reach) continue;
+                if (std::fabs(std::atan2(dx, dy)) > fov / 2.0f) continue;
+                inRange += m.isWall(r, c);
+            }
+    }
+    double avgSeen = double(seen) / frames, avgInRange = double(inRange) / (frames / 50);
+    printf("%.3f ms/frame, %.0f walls in sight vs %.0f in the view wedge (%.1f%% rejected)\n",
+           seconds * 1000.0 / frames, avgSeen, avgInRange, 100.0 * (1.0 - avgSeen / avgInRange));
+}
+
+// Clear `rooms` random rectangles of up to maxSize cells a side, inside the border
+static void carveRooms(Maze& m, int rooms, int maxSize, MazeRng& rng) {
+    for (int i = 0; i < rooms; ++i) {
+        int h = 2 + static_cast<int>(rng.below(maxSize - 1)), w = 2 + static_cast<int>(rng.below(maxSize - 1));
+        int row = 1 + static_cast<int>(rng.below(std::max(1, m.height() - h - 2)));
+        int col = 1 + static_cast<int>(rng.below(std::max(1, m.width() - w - 2)));
+        for (int r = row; r < std::min(row + h, m.height() - 1); ++r)
+            for (int c = col; c < std::min(col + w, m.width() - 1); ++c)
+                m.setWall(r, c, false);
+    }
+}
+
+// --- PVS build: cells per second and compressed size ---
+static void benchPvs() {
+    const int sizes[] = { 64, 256, 512 };
+    printf("%12s %10s %10s %12s %12s\n", "grid", "threads", "seconds", "cells/s", "size KB");
+    for (int size : sizes) {
+        Maze m;
+        generateMaze(m, size, size, MazeAlgorithm::Backtracker, 11);
+        std::size_t open = static_cast<std::size_t>(m.width()) * m.height() - m.wallCount();
+
+        PotentiallyVisibleSet pvs;
+        auto start = Clock::now();
+        pvs.build(m, 75.0f);
+        double seconds = secondsSince(start);
+
+        char grid[32];
+        snprintf(grid, sizeof(grid), "%dx%d", m.width(), m.height());
+        printf("%12s %10u %10.2f %12.0f %12zu\n", grid, std::thread::hardware_concurrency(), seconds,
+               open / seconds, pvs.memoryBytes() / 1024);
+    }
+
+    // Regression check: the set must hold every wall that dense sampling of
+    // the whole cell, edges included, sees on a maze with open rooms
+    Maze m;
+    generateMaze(m, 64, 64, MazeAlgorithm::Kruskal, 3);
+    MazeRng rng(9);
+    carveRooms(m, 68, 16, rng);
+    PotentiallyVisibleSet pvs;
+    pvs.build(m, 75.0f);
+
+    const int cells = 50, points = 12, rays = 8192;
+    std::vector<uint8_t> seen(static_cast<std::size_t>(m.width()) * m.height()), inSet(seen.size());
+    std::vector<std::pair<uint32_t, uint32_t>> runs;
+    int incomplete = 0, missing = 0;
+    for (int i = 0; i < cells; ++i) {
+        int row, col;
+        do {
+            row = static_cast<int>(rng.below(m.height()));
+            col = static_cast<int>(rng.below(m.width()));
+        } while (m.isWall(row, col));
+
+        std::fill(seen.begin(), seen.end(), 0);
+        for (int py = 0; py < points; ++py)
+            for (int px = 0; px < points; ++px) {
+                float gx = col + 0.005f + 0.99f * px / (points - 1), gy = row + 0.005f + 0.99f * py / (points - 1);
+                for (int k = 0; k < rays; ++k) {
+                    float angle = 6.2831853f * k / rays;
+                    walkGridRay(m, gx, gy, std::cos(angle), std::sin(angle), 75.0f, [&](int r, int c) {
+                        if (r >= 0 && r < m.height() && c >= 0 && c < m.width() && m.isWall(r, c))
+                            seen[static_cast<std::size_t>(r) * m.width() + c] = 1;
+                    });
+                }
+            }
+
+        std::fill(inSet.begin(), inSet.end(), 0);
+        pvs.decode(row, col, runs);
+        for (const auto& run : runs)
+            std::fill(inSet.begin() + run.first, inSet.begin() + run.second, 1);
+        int lost = 0;
+        for (std::size_t c = 0; c < seen.size(); ++c)
+            lost += seen[c] && !inSet[c];
+        incomplete += lost > 0;
+        missing += lost;
+    }
+    printf("dense check: %d of %d cells miss %d visible walls\n", incomplete, cells, missing);
+    if (missing) printf("MISMATCH: the PVS is not conservative\n");
+}
+
+// --- Swept circle collision: bodies moved per second ---
+static void benchCollide() {
+    const float spacing = 4.0f, radius = 1.0f;
+    Maze m;
+    generateMaze(m, 256, 256, MazeAlgorithm::Kruskal, 5);
+
+    // Bodies start in room centres and take a large step each tick
+    const int bodies = 10000, ticks = 20;
+    std::vector<glm::vec2> positions(bodies), velocities(bodies);
+    MazeRng rng(3);
+    for (int i = 0; i < bodies; ++i) {
+        int row = 1 + 2 * static_cast<int>(rng.below(256)), col = 1 + 2 * static_cast<int>(rng.below(256));
+        positions[i] = glm::vec2((col + 0.5f) * spacing, -(row + 0.5f) * spacing);
+        float angle = rng.below(360) * 3.14159265f / 180.0f;
+        velocities[i] = glm::vec2(std::cos(angle), std::sin(angle)) * 2.0f;
+    }
+
+    int hits = 0;
+    auto start = Clock::now();
+    for (int t = 0; t < ticks; ++t) {
+        for (int i = 0; i < bodies; ++i) {
+            CircleMove move = moveCircle(m, spacing, positions[i].x, positions[i].y,
+                                         velocities[i].x, velocities[i].y, radius);
+            positions[i] = move.position;
+            hits += move.hit;
+        }
+    }
+    double seconds = secondsSince(start);
+    printf("%d bodies x %d ticks, %d contacts, %.3f ms/tick, %.0f moves/s\n", bodies, ticks, hits,
+           seconds * 1000.0 / ticks, bodies * double(ticks) / seconds);
+}
+
+// --- Batched point queries: bodies tested per second ---
+static void benchBatch() {
+    const float spacing = 4.0f;
+    Maze m;
+    generateMaze(m, 512, 512, MazeAlgorithm::Kruskal, 9);
+
+    // Scatter bodies over the whole grid plus a margin outside it
+    const std::size_t bodies = 100000;
+    const int ticks = 50;
+    std::vector<float> xs(bodies), zs(bodies);
+    std::vector<uint64_t> mask((bodies + 63) / 64);
+    MazeRng rng(11);
+    const float extent = (m.width() + 8) * spacing;
+    for (std::size_t i = 0; i < bodies; ++i) {
+        xs[i] = rng.below(1u << 20) / float(1u << 20) * extent - 4 * spacing;
+        zs[i] = -(rng.below(1u << 20) / float(1u << 20) * extent - 4 * spacing);
+    }
+
+    int scalarHits = 0;
+    auto start = Clock::now();
+    for (int t = 0; t < ticks; ++t)
+        for (std::size_t i = 0; i < bodies; ++i)
+            scalarHits += m.isWall(static_cast<int>(-zs[i] / spacing), static_cast<int>(xs[i] / spacing));
+    double scalarSeconds = secondsSince(start);
+
+    int batchHits = 0;
+    start = Clock::now();
+    for (int t = 0; t < ticks; ++t)
+        checkCollisionBatch(m, spacing, xs.data(), zs.data(), bodies, mask.data());
+    double batchSeconds = secondsSince(start);
+    for (std::size_t i = 0; i < bodies; ++i) batchHits += ((mask[i >> 6] >> (i & 63)) & 1) * ticks;
+
+    printf("%-8s %10s %12s %14s\n", "path", "bodies", "ms/tick", "bodies/s");
+    printf("%-8s %10zu %12.3f %14.0f\n", "scalar", bodies, scalarSeconds * 1000.0 / ticks,
+           bodies * double(ticks) / scalarSeconds);
+    printf("%-8s %10zu %12.3f %14.0f\n", "batch", bodies, batchSeconds * 1000.0 / ticks,
+           bodies * double(ticks) / batchSeconds);
+    if (scalarHits != batchHits)
+        printf("MISMATCH: scalar %d hits, batch %d hits\n", scalarHits, batchHits);
+}
+
+// --- Solvers: entrance to exit on grids from 21x21 to 8193x8193 ---
+static void benchSolve() {
+    const SolverAlgorithm algorithms[] = { SolverAlgorithm::Bfs, SolverAlgorithm::AStar,
+                                           SolverAlgorithm::Bidirectional, SolverAlgorithm::JumpPoint };
+    const int sizes[] = { 10, 64, 512, 2048, 4096 };
+    MazeSolver solver;
+    std::vector<uint32_t> path;
+
+    printf("%12s %-14s %10s %12s %10s %10s\n", "grid", "solver", "path", "expanded", "ms", "MB");
+    for (int size : sizes) {
+        Maze m;
+        generateMaze(m, size, size, MazeAlgorithm::Kruskal, 21);
+        char grid[32];
+        snprintf(grid, sizeof(grid), "%dx%d", m.width(), m.height());
+
+        std::size_t expected = 0;
+        for (SolverAlgorithm algorithm : algorithms) {
+            // Repeat small grids so the timing is measurable
+            const int runs = size <= 64 ? 1000 : 1;
+            bool found = false;
+            auto start = Clock::now();
+            for (int i = 0; i < runs; ++i)
+                found = solver.solve(m, 0, 1, m.height() - 1, m.width() - 2, algorithm, path);
+            double seconds = secondsSince(start) / runs;
+
+            printf("%12s %-14s %10zu %12zu %10.3f %10.1f\n", grid, solverName(algorithm), path.size(),
+                   solver.nodesExpanded(), seconds * 1000.0, solver.memoryBytes() / (1024.0 * 1024.0));
+            if (expected == 0) expected = path.size();
+            if (!found || path.size() != expected)
+                printf("MISMATCH: %s found %zu cells, bfs found %zu\n", solverName(algorithm), path.size(), expected);
+        }
+    }
+}
+
+// --- Jump point search vs A* on mazes with open rooms and long corridors ---
+static void benchJps() {
+    const int sizes[] = { 64, 256, 1024, 2048 };
+    MazeSolver solver;
+    std::vector<uint32_t> path;
+
+    printf("%12s %-8s %10s %12s %10s\n", "grid", "solver", "path", "expanded", "ms");
+    for (int size : sizes) {
+        Maze m;
+        generateMaze(m, size, size, MazeAlgorithm::Kruskal, 33);
+        MazeRng rng(17);
+        // Rooms cover roughly half the grid
+        carveRooms(m, size * size / 256 + 4, 32, rng);
+        char grid[32];
+        snprintf(grid, sizeof(grid), "%dx%d", m.width(), m.height());
+
+        std::size_t expected = 0;
+        for (SolverAlgorithm algorithm : { SolverAlgorithm::AStar, SolverAlgorithm::JumpPoint }) {
+            const int runs = size <= 256 ? 20 : 1;
+            bool found = false;
+            auto start = Clock::now();
+            for (int i = 0; i < runs; ++i)
+                found = solver.solve(m, 0, 1, m.height() - 1, m.width() - 2, algorithm, path);
+            double seconds = secondsSince(start) / runs;
+
+            printf("%12s %-8s %10zu %12zu %10.3f\n", grid, solverName(algorithm), path.size(),
+                   solver.nodesExpanded(), seconds * 1000.0);
+            if (expected == 0) expected = path.size();
+            if (!found || path.size() != expected)
+                printf("MISMATCH: %s found %zu cells, astar found %zu\n", solverName(algorithm), path.size(), expected);
+        }
+    }
+}
+
+// --- Flow field: build, agent steering and incremental wall edits ---
+static void benchFlow() {
+    Maze m;
+    generateMaze(m, 1024, 1024, MazeAlgorithm::Kruskal, 41);
+    MazeRng rng(23);
+    carveRooms(m, 2000, 16, rng);
+    const int goalRow = m.height() - 1, goalCol = m.width() - 2;
+
+    FlowField field;
+    auto start = Clock::now();
+    field.build(m, goalRow, goalCol);
+    double buildSeconds = secondsSince(start);
+    printf("build %dx%d: %.2f ms, %zu cells, %.1f MB\n", m.width(), m.height(), buildSeconds * 1000.0,
+           field.cellsVisited(), field.memoryBytes() / (1024.0 * 1024.0));
+
+    // Agents in random open cells each take one step per tick
+    const int agents = 100000, ticks = 100;
+    std::vector<int> rows(agents), cols(agents);
+    for (int i = 0; i < agents; ++i) {
+        do {
+            rows[i] = static_cast<int>(rng.below(m.height()));
+            cols[i] = static_cast<int>(rng.below(m.width()));
+        } while (m.isWall(rows[i], cols[i]));
+    }
+    int arrived = 0;
+    start = Clock::now();
+    for (int t = 0; t < ticks; ++t)
+        for (int i = 0; i < agents; ++i)
+            if (!field.next(rows[i], cols[i], rows[i], cols[i])) ++arrived;
+    double steerSeconds = secondsSince(start);
+    printf("steer: %d agents x %d ticks, %.3f ms/tick, %.0f steps/s\n", agents, ticks,
+           steerSeconds * 1000.0 / ticks, agents * double(ticks) / steerSeconds);
+
+    // Toggle random cells, then check the result against a full rebuild
+    const int edits = 2000;
+    std::size_t touched = 0;
+    start = Clock::now();
+    for (int i = 0; i < edits; ++i) {
+        int row = 1 + static_cast<int>(rng.below(m.height() - 2)), col = 1 + static_cast<int>(rng.below(m.width() - 2));
+        m.setWall(row, col, !m.isWall(row, col));
+        field.wallChanged(m, row, col);
+        touched += field.cellsVisited();
+    }
+    double editSeconds = secondsSince(start);
+    printf("edit: %d toggles, %.3f ms each (rebuild %.2f ms), %.0f cells revisited each\n", edits,
+           editSeconds * 1000.0 / edits, buildSeconds * 1000.0, double(touched) / edits);
+
+    FlowField fresh;
+    fresh.build(m, goalRow, goalCol);
+    for (int r = 0; r < m.height(); ++r) {
+        for (int c = 0; c < m.width(); ++c) {
+            if (field.distance(r, c) != fresh.distance(r, c)) {
+                printf("MISMATCH at (%d, %d): incremental %u, rebuilt %u\n", r, c, field.distance(r, c),
+                       fresh.distance(r, c));
+                return;
+            }
+        }
+    }
+}
+
+// --- Parallel BFS: distance map build time against thread count ---
+static void benchParallelBfs() {
+    // 8193x8193 grid; pass a larger room count here for 16k grids if memory allows
+    const int rooms = 4096;
+    Maze m;
+    generateMaze(m, rooms, rooms, MazeAlgorithm::Kruskal, 51);
+    MazeRng rng(29);
+    carveRooms(m, rooms * rooms / 256, 32, rng);
+    const int goalRow = m.height() - 1, goalCol = m.width() - 2;
+
+    FlowField serial;
+    auto start = Clock::now();
+    serial.build(m, goalRow, goalCol);
+    double serialSeconds = secondsSince(start);
+    printf("%dx%d grid, %zu cells reached\n", m.width(), m.height(), serial.cellsVisited());
+    printf("%8s %10s %10s\n", "threads", "ms", "speedup");
+    printf("%8s %10.1f %10.2f\n", "serial", serialSeconds * 1000.0, 1.0);
+
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    FlowField field;
+    for (int threads = 1; threads <= std::max(16, hardware); threads *= 2) {
+        start = Clock::now();
+        field.buildParallel(m, goalRow, goalCol, threads);
+        double seconds = secondsSince(start);
+        printf("%8d %10.1f %10.2f%s\n", threads, seconds * 1000.0, serialSeconds / seconds,
+               threads > hardware ? "  (oversubscribed)" : "");
+
+        for (int r = 0; r < m.height(); ++r) {
+            for (int c = 0; c < m.width(); ++c) {
+                if (field.distance(r, c) != serial.distance(r, c)) {
+                    printf("MISMATCH at (%d, %d): parallel %u, serial %u\n", r, c, field.distance(r, c),
+                           serial.distance(r, c));
+                    return;
+                }
+            }
+        }
+    }
+}
+
+// --- Hierarchical planner: per-query cost against full A* ---
+static void benchHpa() {
+    const int rooms = 2048;
+    const int queries = 200, agents = 500, goalCount = 4, astarQueries = 20;
+    printf("%-8s %10s %10s %8s %10s %10s %10s %10s %10s %8s %8s\n", "maze", "build ms", "nodes", "MB",
+           "plan ms", "cache ms", "agent ms", "refine ms", "astar ms", "length", "worst");
+
+    for (int carve = 0; carve < 2; ++carve) {
+        Maze m;
+        generateMaze(m, rooms, rooms, MazeAlgorithm::Kruskal, 61);
+        MazeRng rng(37);
+        if (carve) carveRooms(m, rooms * rooms / 256, 32, rng);
+
+        HierarchicalPlanner planner;
+        auto start = Clock::now();
+        planner.build(m);
+        double buildSeconds = secondsSince(start);
+
+        // Random open start and goal cells
+        auto randomOpen = [&](int& row, int& col) {
+            do {
+                row = static_cast<int>(rng.below(m.height()));
+                col = static_cast<int>(rng.below(m.width()));
+            } while (m.isWall(row, col));
+        };
+        std::vector<int> ends(4 * queries);
+        for (int i = 0; i < 2 * queries; ++i)
+            randomOpen(ends[2 * i], ends[2 * i + 1]);
+
+        // An agent plans the whole route but only refines the leg it is on
+        std::vector<uint32_t> waypoints, cells, exact;
+        double planSeconds = 0, refineSeconds = 0;
+        for (int q = 0; q < queries; ++q) {
+            const int* e = &ends[4 * q];
+            start = Clock::now();
+            bool found = planner.plan(m, e[0], e[1], e[2], e[3], waypoints);
+            planSeconds += secondsSince(start);
+            start = Clock::now();
+            cells.clear();
+            if (found && waypoints.size() > 1) planner.refine(m, waypoints[0], waypoints[1], cells);
+            refineSeconds += secondsSince(start);
+        }
+
+        // A crowd: many agents sharing a few cached goals
+        int goals[goalCount][2];
+        start = Clock::now();
+        for (auto& goal : goals) {
+            randomOpen(goal[0], goal[1]);
+            planner.cacheGoal(m, goal[0], goal[1]);
+        }
+        double cacheSeconds = secondsSince(start);
+        double agentSeconds = 0;
+        for (int a = 0; a < agents; ++a) {
+            int row, col;
+            randomOpen(row, col);
+            const int* goal = goals[a % goalCount];
+            start = Clock::now();
+            planner.plan(m, row, col, goal[0], goal[1], waypoints);
+            agentSeconds += secondsSince(start);
+        }
+
+        // Full refinement against A* on a few of the same queries, uncached
+        // and cached
+        MazeSolver solver;
+        double astarSeconds = 0, lengthRatio = 0, worst = 0;
+        int compared = 0;
+        for (int q = 0; q < astarQueries; ++q) {
+            const int* e = &ends[4 * q];
+            start = Clock::now();
+            bool found = solver.aStar(m, e[0], e[1], e[2], e[3], exact);
+            astarSeconds += secondsSince(start);
+            if (!found) continue;
+            for (int cached = 0; cached < 2; ++cached) {
+                if (cached) planner.cacheGoal(m, e[2], e[3]);
+                if (!planner.plan(m, e[0], e[1], e[2], e[3], waypoints) || !planner.refineAll(m, waypoints, cells)) {
+                    printf("MISMATCH: query %d reachable by A* but not by the planner\n", q);
+                    continue;
+                }
+                double ratio = double(cells.size()) / exact.size();
+                lengthRatio += ratio;
+                worst = std::max(worst, ratio);
+                ++compared;
+            }
+        }
+
+        printf("%-8s %10.1f %10zu %8.1f %10.3f %10.1f %10.4f %10.4f %10.2f %7.3fx %7.3fx\n",
+               carve ? "rooms" : "perfect", buildSeconds * 1000.0, planner.nodeCount(),
+               planner.memoryBytes() / (1024.0 * 1024.0), planSeconds * 1000.0 / queries,
+               cacheSeconds * 1000.0 / goalCount, agentSeconds * 1000.0 / agents,
+               refineSeconds * 1000.0 / queries, astarSeconds * 1000.0 / astarQueries,
+               compared ? lengthRatio / compared : 0.0, worst);
+    }
+}
+
+// --- Crowd: agents moved per millisecond, per worker thread ---
+static void benchCrowd() {
+    const float spacing = 4.0f, dt = 1.0f / 60.0f;
+    const int agents = 100000, ticks = 60;
+    Maze m;
+    generateMaze(m, 256, 256, MazeAlgorithm::Kruskal, 71);
+    MazeRng rng(43);
+    carveRooms(m, 256, 16, rng);
+
+    printf("%8s %10s %12s %16s %10s\n", "threads", "agents", "ms/tick", "agents/ms/core", "arrived");
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardware; threads *= 2) {
+        Crowd crowd(threads);
+        int goal = crowd.addGoal(m, m.height() - 1, m.width() - 2);
+        crowd.spawn(m, spacing, agents, goal, 5);
+
+        auto start = Clock::now();
+        for (int t = 0; t < ticks; ++t)
+            crowd.update(m, spacing, dt);
+        double seconds = secondsSince(start);
+        double perTick = seconds * 1000.0 / ticks;
+        printf("%8d %10zu %12.3f %16.0f %10zu\n", threads, crowd.size(), perTick,
+               crowd.size() / perTick / threads, crowd.arrivedCount());
+    }
+}
+
+struct Suite {
+    const char* name;
+    void (*run)();
+};
+
+// --- Software rasterizer: frames per second by thread count ---
+// The camera turns on the spot at the entrance; every thread count must
+// produce the same pixels as one thread
+static void benchRaster() {
+    const float spacing = 4.0f;
+    const int width = 800, height = 600, frames = 24;
+    Maze m;
+    generateMaze(m, 64, 64, MazeAlgorithm::Backtracker, 3);
+
+    RasterFrame frame = {};
+    frame.projection = glm::perspective(glm::radians(65.0f), (float)width / height, 0.1f, 300.0f);
+    frame.lightColor = glm::vec3(1.0f);
+    frame.objectColor = glm::vec3(0.2f, 0.6f, 1.0f);
+    frame.cutOff = std::cos(glm::radians(8.5f));
+    frame.outerCutOff = std::cos(glm::radians(15.0f));
+    frame.clearColor = glm::vec3(0.05f, 0.05f, 0.1f);
+    const glm::vec3 eye(spacing * 1.5f, 4.0f, -spacing * 1.5f);
+
+    printf("%8s %10s %12s %10s %12s\n", "threads", "pixels", "ms/frame", "fps", "triangles");
+    std::vector<uint64_t> reference;
+    const int hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (int threads = 1; threads <= hardware; threads *= 2) {
+        SoftwareRasterizer raster(threads);
+        raster.setScene(m, spacing);
+        raster.resize(width, height);
+
+        std::vector<uint64_t> hashes;
+        std::size_t triangles = 0;
+        auto start = Clock::now();
+        for (int f = 0; f < frames; ++f) {
+            float yaw = glm::radians(360.0f * f / frames);
+            glm::vec3 front(std::cos(yaw), 0.0f, std::sin(yaw));
+            frame.view = glm::lookAt(eye, eye + front, glm::vec3(0.0f, 1.0f, 0.0f));
+            frame.lightPos = frame.viewPos = eye;
+            frame.lightDir = front;
+            raster.render(frame);
+            triangles += raster.trianglesDrawn();
+
+            uint64_t h = 1469598103934665603ull; // FNV-1a over the pixels
+            for (uint32_t p : raster.pixels()) h = (h ^ p) * 1099511628211ull;
+            hashes.push_back(h);
+        }
+        double perFrame = secondsSince(start) * 1000.0 / frames;
+        printf("%8d %10d %12.3f %10.1f %12zu\n", threads, width * height, perFrame, 1000.0 / perFrame,
+               triangles / frames);
+        if (reference.empty()) reference = hashes;
+        else if (hashes != reference) printf("MISMATCH: image differs from the single-threaded render\n");
+    }
+}
+
+static const Suite suites[] = {
+    { "generate", benchGenerate },
+    { "cull", benchCull },
+    { "visibility", benchVisibility },
+    { "pvs", benchPvs },
+    { "collide", benchCollide },
+    { "batch", benchBatch },
+    { "solve", benchSolve },
+    { "jps", benchJps },
+    { "flow", benchFlow },
+    { "parallel-bfs", benchParallelBfs },
+    { "hpa", benchHpa },
+    { "crowd", benchCrowd },
+    { "raster", benchRaster },
+};
+
+int main(int argc, char** argv) {
+    const char* only = argc > 1 ? argv[1] : nullptr;
+    bool ran = false;
+    for (const Suite& suite : suites) {
+        if (only && std::strcmp(only, suite.name) != 0) continue;
+        printf("== %s ==\n", suite.name);
+        suite.run();
+        printf("\n");
+        ran = true;
+    }
+    if (!ran) {
+        fprintf(stderr, "Unknown suite '%s'\n", only);
+        return 1;
+    }
+    return 0;
+}
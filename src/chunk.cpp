@@ -0,0 +1,99 @@
+#include "chunk.h"
+#include "wall_mesh.h"
+#include <GL/glew.h>
+#include "gl_stats.h" // after the GL header it wraps
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+void ChunkManager::update(const Maze& m, float spacing, float camX, float camZ) {
+    const int chunkRows = (m.height() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int chunkCols = (m.width() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int camRow = static_cast<int>(-camZ / spacing) / CHUNK_SIZE;
+    const int camCol = static_cast<int>(camX / spacing) / CHUNK_SIZE;
+
+    // Release chunks that left the radius
+    for (auto it = chunks.begin(); it != chunks.end(); ) {
+        const MazeChunk& c = it->second;
+        if (std::abs(c.chunkRow - camRow) > radius || std::abs(c.chunkCol - camCol) > radius) {
+            release(it->second);
+            it = chunks.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Collect missing chunks inside the radius, nearest first
+    std::vector<MazeChunk> missing;
+    for (int cr = std::max(0, camRow - radius); cr <= std::min(chunkRows - 1, camRow + radius); ++cr) {
+        for (int cc = std::max(0, camCol - radius); cc <= std::min(chunkCols - 1, camCol + radius); ++cc) {
+            if (chunks.count(key(cr, cc))) continue;
+            MazeChunk chunk;
+            chunk.chunkRow = cr;
+            chunk.chunkCol = cc;
+            missing.push_back(chunk);
+        }
+    }
+    auto distance = [&](const MazeChunk& c) {
+        return std::max(std::abs(c.chunkRow - camRow), std::abs(c.chunkCol - camCol));
+    };
+    std::sort(missing.begin(), missing.end(),
+              [&](const MazeChunk& a, const MazeChunk& b) { return distance(a) < distance(b); });
+
+    int budget = rebuildAll ? static_cast<int>(missing.size()) : buildsPerFrame;
+    for (int i = 0; i < budget && i < static_cast<int>(missing.size()); ++i) {
+        MazeChunk& chunk = chunks[key(missing[i].chunkRow, missing[i].chunkCol)];
+        chunk = missing[i];
+        build(chunk, m, spacing);
+    }
+    rebuildAll = false;
+}
+
+void ChunkManager::build(MazeChunk& chunk, const Maze& m, float spacing) {
+    chunk.row0 = chunk.chunkRow * CHUNK_SIZE;
+    chunk.col0 = chunk.chunkCol * CHUNK_SIZE;
+    chunk.rows = std::min(CHUNK_SIZE, m.height() - chunk.row0);
+    chunk.cols = std::min(CHUNK_SIZE, m.width() - chunk.col0);
+
+    chunk.wallCells = 0;
+    for (int r = chunk.row0; r < chunk.row0 + chunk.rows; ++r)
+        for (int c = chunk.col0; c < chunk.col0 + chunk.cols; ++c)
+            chunk.wallCells += m.isWall(r, c);
+
+    chunk.boundsMin = glm::vec3(chunk.col0 * spacing, 0.0f, -(chunk.row0 + chunk.rows) * spacing);
+    chunk.boundsMax = glm::vec3((chunk.col0 + chunk.cols) * spacing, spacing * WALL_HEIGHT_SCALE,
+                                -chunk.row0 * spacing);
+
+    std::vector<float> vertices;
+    buildWallMesh(m, spacing, chunk.row0, chunk.col0, chunk.rows, chunk.cols, vertices);
+    chunk.vertexCount = static_cast<int>(vertices.size() / 6);
+    if (chunk.vertexCount == 0) return;
+
+    glGenVertexArrays(1, &chunk.vao);
+    glGenBuffers(1, &chunk.vbo);
+    glBindVertexArray(chunk.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+}
+
+void ChunkManager::release(MazeChunk& chunk) {
+    if (chunk.vbo) glDeleteBuffers(1, &chunk.vbo);
+    if (chunk.vao) glDeleteVertexArrays(1, &chunk.vao);
+    chunk.vao = chunk.vbo = 0;
+    chunk.vertexCount = 0;
+}
+
+void ChunkManager::invalidate() {
+    clear();
+    rebuildAll = true;
+}
+
+void ChunkManager::clear() {
+    for (auto& entry : chunks)
+        release(entry.second);
+    chunks.clear();
+}
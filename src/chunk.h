@@ -0,0 +1,55 @@
+#ifndef CHUNK_H
+#define CHUNK_H
+
+#include "maze_grid.h"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
+
+// Cells per chunk side
+const int CHUNK_SIZE = 32;
+
+// One CHUNK_SIZE x CHUNK_SIZE block of the maze with its own GPU mesh
+struct MazeChunk {
+    int chunkRow = 0, chunkCol = 0;   // chunk coordinates (cell row / col divided by CHUNK_SIZE)
+    int row0 = 0, col0 = 0;           // first cell covered
+    int rows = 0, cols = 0;           // cells covered (smaller at the maze edge)
+    glm::vec3 boundsMin, boundsMax;   // world-space AABB of the walls
+    int wallCells = 0;                // wall cells inside the chunk
+    unsigned int vao = 0, vbo = 0;
+    int vertexCount = 0;
+};
+
+// Keeps the chunks within `radius` chunks of the camera resident on the GPU.
+// Chunks are built nearest-first, a few per frame, and released once they
+// fall outside the radius. Collision keeps reading the packed Maze grid,
+// which at one bit per cell stays resident even for 4k x 4k maps.
+class ChunkManager {
+public:
+    ChunkManager(int radius = 3, int buildsPerFrame = 8)
+        : radius(radius), buildsPerFrame(buildsPerFrame) {}
+
+    // Create/destroy chunks around the camera
+    void update(const Maze& m, float spacing, float camX, float camZ);
+    // Drop every chunk; the next update() rebuilds the whole radius at once
+    void invalidate();
+    // Release all GL objects (needs a current context)
+    void clear();
+
+    const std::unordered_map<uint64_t, MazeChunk>& resident() const { return chunks; }
+
+private:
+    static uint64_t key(int chunkRow, int chunkCol) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkRow)) << 32) |
+               static_cast<uint32_t>(chunkCol);
+    }
+    void build(MazeChunk& chunk, const Maze& m, float spacing);
+    void release(MazeChunk& chunk);
+
+    int radius;
+    int buildsPerFrame;
+    bool rebuildAll = true;
+    std::unordered_map<uint64_t, MazeChunk> chunks;
+};
+
+#endif
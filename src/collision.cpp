@@ -0,0 +1,150 @@
+#include "collision.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Push the circle out of every wall cell it overlaps; returns true on contact
+static bool resolveWalls(const Maze& m, float spacing, glm::vec2& p, float radius) {
+    bool hit = false;
+    const int col0 = static_cast<int>(std::floor((p.x - radius) / spacing));
+    const int col1 = static_cast<int>(std::floor((p.x + radius) / spacing));
+    const int row0 = static_cast<int>(std::floor(-(p.y + radius) / spacing));
+    const int row1 = static_cast<int>(std::floor(-(p.y - radius) / spacing));
+
+    for (int row = row0; row <= row1; ++row) {
+        for (int col = col0; col <= col1; ++col) {
+            if (!m.isWall(row, col)) continue;
+
+            // Cell footprint on the XZ plane
+            float minX = col * spacing, maxX = minX + spacing;
+            float maxZ = -row * spacing, minZ = maxZ - spacing;
+
+            glm::vec2 closest(std::min(std::max(p.x, minX), maxX), std::min(std::max(p.y, minZ), maxZ));
+            glm::vec2 d = p - closest;
+
+            // An edge shared with a neighbouring wall cell is interior to the
+            // wall; pushing off it would nudge the circle sideways as it slides
+            bool outsideX = p.x < minX || p.x > maxX, outsideZ = p.y < minZ || p.y > maxZ;
+            if (outsideX && m.isWall(row, p.x < minX ? col - 1 : col + 1)) d.x = 0.0f;
+            if (outsideZ && m.isWall(p.y > maxZ ? row - 1 : row + 1, col)) d.y = 0.0f;
+            if ((outsideX || outsideZ) && d.x == 0.0f && d.y == 0.0f) continue;
+
+            float dist2 = glm::dot(d, d);
+            if (dist2 >= radius * radius) continue;
+
+            if (dist2 > 1e-12f) {
+                float dist = std::sqrt(dist2);
+                p += d * ((radius - dist) / dist);
+            } else {
+                // Centre inside the cell: leave through the nearest face
+                float left = p.x - minX, right = maxX - p.x;
+                float back = p.y - minZ, front = maxZ - p.y;
+                float best = std::min(std::min(left, right), std::min(back, front));
+                if (best == left) p.x = minX - radius;
+                else if (best == right) p.x = maxX + radius;
+                else if (best == back) p.y = minZ - radius;
+                else p.y = maxZ + radius;
+            }
+            hit = true;
+        }
+    }
+    return hit;
+}
+
+CircleMove moveCircle(const Maze& m, float spacing, float x, float z, float dx, float dz, float radius) {
+    CircleMove result;
+    result.position = glm::vec2(x, z);
+
+    glm::vec2 delta(dx, dz);
+    float length = glm::length(delta);
+    float maxStep = std::max(radius * 0.5f, 1e-3f);
+    int steps = std::max(1, static_cast<int>(std::ceil(length / maxStep)));
+    glm::vec2 step = delta / static_cast<float>(steps);
+
+    for (int i = 0; i < steps; ++i) {
+        result.position += step;
+        // Two passes settle the circle when it touches two cells at a corner
+        for (int pass = 0; pass < 2; ++pass) {
+            if (!resolveWalls(m, spacing, result.position, radius)) break;
+            result.hit = true;
+        }
+    }
+    return result;
+}
+
+// --- Batched point queries ---
+static inline bool pointInWall(const Maze& m, float spacing, float x, float z) {
+    int col = static_cast<int>(x / spacing);
+    int row = static_cast<int>(-z / spacing);
+    return m.isWall(row, col);
+}
+
+void checkCollisionBatch(const Maze& m, float spacing, const float* xs, const float* zs,
+                         std::size_t count, uint64_t* hitMask) {
+    std::memset(hitMask, 0, ((count + 63) / 64) * sizeof(uint64_t));
+    std::size_t i = 0;
+
+#if defined(MAZE_SIMD_AVX2)
+    // The grid viewed as 32-bit words: bit col & 31 of word row * stride32 + col / 32
+    const int* grid32 = reinterpret_cast<const int*>(m.words());
+    // Divide rather than multiply by a reciprocal so cell edges round exactly
+    // like checkCollision()
+    const __m256 spacingV = _mm256_set1_ps(spacing);
+    const __m256 negSpacing = _mm256_set1_ps(-spacing);
+    const __m256i width = _mm256_set1_epi32(m.width());
+    const __m256i height = _mm256_set1_epi32(m.height());
+    const __m256i stride32 = _mm256_set1_epi32(static_cast<int>(m.wordsPerRow() * 2));
+    const __m256i minusOne = _mm256_set1_epi32(-1);
+    const __m256i thirtyOne = _mm256_set1_epi32(31);
+    const __m256i one = _mm256_set1_epi32(1);
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i col = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_loadu_ps(xs + i), spacingV));
+        __m256i row = _mm256_cvttps_epi32(_mm256_div_ps(_mm256_loadu_ps(zs + i), negSpacing));
+
+        // 0 <= col < width && 0 <= row < height
+        __m256i inside = _mm256_and_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi32(col, minusOne), _mm256_cmpgt_epi32(width, col)),
+            _mm256_and_si256(_mm256_cmpgt_epi32(row, minusOne), _mm256_cmpgt_epi32(height, row)));
+
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(row, stride32), _mm256_srli_epi32(col, 5));
+        __m256i word = _mm256_mask_i32gather_epi32(_mm256_setzero_si256(), grid32, index, inside, 4);
+        __m256i bit = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_and_si256(col, thirtyOne)), one);
+        __m256i hit = _mm256_and_si256(_mm256_cmpeq_epi32(bit, one), inside);
+
+        uint64_t mask = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+        hitMask[i >> 6] |= mask << (i & 63);
+    }
+#elif defined(MAZE_SIMD_SSE2)
+    // No gather before AVX2: vectorize the cell math, then test the four
+    // bits with scalar loads from the packed rows
+    const __m128 spacingV = _mm_set1_ps(spacing);
+    const __m128 negSpacing = _mm_set1_ps(-spacing);
+    const uint64_t* grid = m.words();
+    const int width = m.width(), height = m.height();
+    const std::size_t stride = m.wordsPerRow();
+
+    for (; i + 4 <= count; i += 4) {
+        alignas(16) int cols[4], rows[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(cols),
+                        _mm_cvttps_epi32(_mm_div_ps(_mm_loadu_ps(xs + i), spacingV)));
+        _mm_store_si128(reinterpret_cast<__m128i*>(rows),
+                        _mm_cvttps_epi32(_mm_div_ps(_mm_loadu_ps(zs + i), negSpacing)));
+
+        uint64_t mask = 0;
+        for (int k = 0; k < 4; ++k) {
+            int col = cols[k], row = rows[k];
+            if (static_cast<unsigned>(col) >= static_cast<unsigned>(width) ||
+                static_cast<unsigned>(row) >= static_cast<unsigned>(height))
+                continue;
+            mask |= ((grid[row * stride + (col >> 6)] >> (col & 63)) & 1u) << k;
+        }
+        hitMask[i >> 6] |= mask << (i & 63);
+    }
+#endif
+
+    for (; i < count; ++i)
+        if (pointInWall(m, spacing, xs[i], zs[i]))
+            hitMask[i >> 6] |= uint64_t(1) << (i & 63);
+}
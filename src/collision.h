@@ -0,0 +1,32 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include "maze_grid.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+
+// Result of moving a circle through the maze
+struct CircleMove {
+    glm::vec2 position; // final (x, z)
+    bool hit = false;   // true if any wall changed the motion
+};
+
+// Move a circle of the given radius from (x, z) by (dx, dz) on the XZ plane.
+// The motion is split into sub-steps no longer than half the radius, so the
+// circle can never pass through a wall regardless of speed or frame time.
+// After each sub-step it is pushed out of every overlapping wall cell along
+// the contact normal, which leaves the tangential part of the motion intact:
+// the body slides along walls and around corners instead of sticking.
+CircleMove moveCircle(const Maze& m, float spacing, float x, float z, float dx, float dz, float radius);
+
+// Batched point query with the same rules as checkCollision(): the cell is
+// (int(x / spacing), int(-z / spacing)) and cells outside the grid are open.
+// Positions are structure-of-arrays; bit i of hitMask (64 bodies per word,
+// (count + 63) / 64 words) is set when body i is inside a wall. Uses AVX2
+// gathers from the packed grid (8 bodies per step) or SSE2 index math
+// (4 per step) when the compiler targets them, scalar code otherwise.
+void checkCollisionBatch(const Maze& m, float spacing, const float* xs, const float* zs,
+                         std::size_t count, uint64_t* hitMask);
+
+#endif
@@ -0,0 +1,114 @@
+#include "crowd.h"
+#include "collision.h"
+#include "generator.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cmath>
+
+// Step directions: east, south, west, north (as stored in the flow field)
+static const int DC[4] = { 1, 0, -1, 0 };
+static const int DR[4] = { 0, 1, 0, -1 };
+
+Crowd::Crowd(int threads) : pool(threads) {}
+
+int Crowd::addGoal(const Maze& m, int row, int col) {
+    fields.emplace_back();
+    fields.back().build(m, row, col);
+    goalCells.emplace_back(row, col);
+    return static_cast<int>(fields.size()) - 1;
+}
+
+void Crowd::refreshGoals(const Maze& m) {
+    for (std::size_t i = 0; i < fields.size(); ++i)
+        fields[i].build(m, goalCells[i].first, goalCells[i].second);
+}
+
+void Crowd::spawn(const Maze& m, float spacing, int count, int goalIndex, uint64_t seed) {
+    MazeRng rng(seed);
+    const FlowField& field = fields[goalIndex];
+    const std::size_t first = size();
+    posX.reserve(first + count);
+    posZ.reserve(first + count);
+    for (int i = 0; i < count; ++i) {
+        // Random cells that can reach the goal; give up on mazes with none
+        int row = 0, col = 0, tries = 0;
+        do {
+            row = static_cast<int>(rng.below(m.height()));
+            col = static_cast<int>(rng.below(m.width()));
+        } while (field.step(row, col) == FlowField::BLOCKED && ++tries < 1000);
+        if (field.step(row, col) == FlowField::BLOCKED) return;
+
+        posX.push_back((col + 0.5f) * spacing);
+        posZ.push_back(-(row + 0.5f) * spacing);
+        velX.push_back(0.0f);
+        velZ.push_back(0.0f);
+        goal.push_back(static_cast<uint16_t>(goalIndex));
+        state.push_back(AgentState::Walking);
+    }
+}
+
+void Crowd::clear() {
+    posX.clear();
+    posZ.clear();
+    velX.clear();
+    velZ.clear();
+    goal.clear();
+    state.clear();
+}
+
+std::size_t Crowd::arrivedCount() const {
+    return static_cast<std::size_t>(std::count(state.begin(), state.end(), AgentState::Arrived));
+}
+
+// --- Tick ---
+void Crowd::updateRange(const Maze& m, float spacing, float dt, std::size_t first, std::size_t last) {
+    PROFILE_SCOPE("crowd agents");
+    const float blend = std::min(1.0f, steering * dt);
+
+    for (std::size_t i = first; i < last; ++i) {
+        if (state[i] == AgentState::Arrived) continue;
+        const FlowField& field = fields[goal[i]];
+        const float x = posX[i], z = posZ[i];
+        const int row = static_cast<int>(std::floor(-z / spacing));
+        const int col = static_cast<int>(std::floor(x / spacing));
+
+        // Head for the centre of the next cell on the way to the goal
+        float wantX = 0.0f, wantZ = 0.0f;
+        const uint8_t step = field.step(row, col);
+        if (step == FlowField::GOAL) {
+            state[i] = AgentState::Arrived;
+            velX[i] = velZ[i] = 0.0f;
+            continue;
+        }
+        if (step != FlowField::BLOCKED) {
+            float dx = (col + DC[step] + 0.5f) * spacing - x;
+            float dz = -(row + DR[step] + 0.5f) * spacing - z;
+            float length = std::sqrt(dx * dx + dz * dz);
+            if (length > 1e-6f) {
+                wantX = dx / length * speed;
+                wantZ = dz / length * speed;
+            }
+            state[i] = AgentState::Walking;
+        } else {
+            state[i] = AgentState::Stuck;
+        }
+
+        velX[i] += (wantX - velX[i]) * blend;
+        velZ[i] += (wantZ - velZ[i]) * blend;
+        CircleMove move = moveCircle(m, spacing, x, z, velX[i] * dt, velZ[i] * dt, radius);
+        posX[i] = move.position.x;
+        posZ[i] = move.position.y;
+    }
+}
+
+void Crowd::update(const Maze& m, float spacing, float dt) {
+    const std::size_t count = size();
+    const int slices = pool.size();
+    // Small crowds are not worth waking the pool for
+    if (slices == 1 || count < 1024) {
+        updateRange(m, spacing, dt, 0, count);
+        return;
+    }
+    // Thread t takes slice t of the agents
+    pool.run([&](int t) { updateRange(m, spacing, dt, count * t / slices, count * (t + 1) / slices); });
+}
@@ -0,0 +1,57 @@
+#ifndef CROWD_H
+#define CROWD_H
+
+#include "flowfield.h"
+#include "maze_grid.h"
+#include "worker_pool.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+enum class AgentState : uint8_t { Walking, Arrived, Stuck };
+
+// NPC crowd walking the maze. Components live in parallel arrays indexed
+// by agent, so a tick streams through memory. Every agent follows the flow
+// field of its goal, so thousands of agents share a handful of searches,
+// and moves with the same swept-circle collision as the camera. Ticks are
+// split into ranges over a pool of worker threads, started once.
+class Crowd {
+public:
+    // threads = 0 uses every hardware thread
+    explicit Crowd(int threads = 0);
+
+    // Returns the goal index for spawn(); rebuild with refreshGoals() after
+    // the maze changes
+    int addGoal(const Maze& m, int row, int col);
+    void refreshGoals(const Maze& m);
+    // Place count agents in random open cells, all heading for goal
+    void spawn(const Maze& m, float spacing, int count, int goal, uint64_t seed);
+    void clear();
+
+    // Advance every agent by dt seconds
+    void update(const Maze& m, float spacing, float dt);
+
+    std::size_t size() const { return posX.size(); }
+    std::size_t arrivedCount() const;
+    int threadCount() const { return pool.size(); }
+
+    // Components
+    std::vector<float> posX, posZ;
+    std::vector<float> velX, velZ;
+    std::vector<uint16_t> goal;
+    std::vector<AgentState> state;
+
+    float speed = 6.0f;      // units per second
+    float steering = 8.0f;   // how quickly velocity turns towards the flow, per second
+    float radius = 0.6f;
+
+private:
+    void updateRange(const Maze& m, float spacing, float dt, std::size_t first, std::size_t last);
+
+    std::vector<FlowField> fields;
+    std::vector<std::pair<int, int>> goalCells;
+    WorkerPool pool;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#include "crowd_render.h"
+#include "shader.h"
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// Unit cube centred on the origin: positions and normals, 36 vertices
+static const float CUBE_VERTICES[] = {
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,   0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
+     0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,   0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
+    -0.5f, -0.5f, -0.5f,  0.0f,  0.0f, -1.0f,  -0.5f,  0.5f, -0.5f,  0.0f,  0.0f, -1.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,   0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
+     0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,   0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
+    -0.5f,  0.5f,  0.5f,  0.0f,  0.0f,  1.0f,  -0.5f, -0.5f,  0.5f,  0.0f,  0.0f,  1.0f,
+    -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  -0.5f,  0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
+    -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,  -0.5f, -0.5f, -0.5f, -1.0f,  0.0f,  0.0f,
+    -0.5f, -0.5f,  0.5f, -1.0f,  0.0f,  0.0f,  -0.5f,  0.5f,  0.5f, -1.0f,  0.0f,  0.0f,
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,   0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
+     0.5f,  0.5f, -0.5f,  1.0f,  0.0f,  0.0f,   0.5f, -0.5f, -0.5f,  1.0f,  0.0f,  0.0f,
+     0.5f,  0.5f,  0.5f,  1.0f,  0.0f,  0.0f,   0.5f, -0.5f,  0.5f,  1.0f,  0.0f,  0.0f,
+    -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,   0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
+     0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,   0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,
+    -0.5f, -0.5f,  0.5f,  0.0f, -1.0f,  0.0f,  -0.5f, -0.5f, -0.5f,  0.0f, -1.0f,  0.0f,
+    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,   0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
+     0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,   0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
+    -0.5f,  0.5f, -0.5f,  0.0f,  1.0f,  0.0f,  -0.5f,  0.5f,  0.5f,  0.0f,  1.0f,  0.0f,
+};
+
+void CrowdRenderer::create() {
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &meshVBO);
+    glGenBuffers(1, &instanceVBO);
+    glBindVertexArray(vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, meshVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(CUBE_VERTICES), CUBE_VERTICES, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    glBindVertexArray(0);
+    instanceCapacity = 0;
+}
+
+void CrowdRenderer::destroy() {
+    if (instanceVBO) glDeleteBuffers(1, &instanceVBO);
+    if (meshVBO) glDeleteBuffers(1, &meshVBO);
+    if (vao) glDeleteVertexArrays(1, &vao);
+    vao = meshVBO = instanceVBO = 0;
+    instanceCapacity = 0;
+}
+
+void CrowdRenderer::draw(const ShaderProgram& shader, const Crowd& crowd, float spacing) {
+    const std::size_t count = crowd.size();
+    if (!vao || count == 0) return;
+
+    offsets.resize(count * 3);
+    for (std::size_t i = 0; i < count; ++i) {
+        offsets[i * 3 + 0] = crowd.posX[i];
+        offsets[i * 3 + 1] = 0.0f;
+        offsets[i * 3 + 2] = crowd.posZ[i];
+    }
+
+    // Orphan the buffer when it grows, otherwise overwrite in place
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    if (count > instanceCapacity) {
+        instanceCapacity = count + count / 2;
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity * 3 * sizeof(float), nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, count * 3 * sizeof(float), offsets.data());
+
+    // A box the agent's diameter across, standing on the floor
+    const float side = crowd.radius * 2.0f, height = spacing * 0.5f;
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, height / 2.0f, 0.0f));
+    model = glm::scale(model, glm::vec3(side, height, side));
+    glm::mat3 normalMatrix = glm::inverseTranspose(glm::mat3(model));
+    glUniformMatrix4fv(shader.modelLocation(), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix3fv(shader.normalMatrixLocation(), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+
+    glBindVertexArray(vao);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, static_cast<GLsizei>(count));
+    glBindVertexArray(0);
+}
@@ -0,0 +1,25 @@
+#ifndef CROWD_RENDER_H
+#define CROWD_RENDER_H
+
+#include "crowd.h"
+#include <vector>
+
+class ShaderProgram;
+
+// Draws every agent of a crowd as a box with one instanced call: the box
+// is shared, and a per-instance offset (shader.vert attribute 2) places it.
+class CrowdRenderer {
+public:
+    // Needs a current GL context
+    void create();
+    void destroy();
+    // Upload the agent positions and draw them; spacing scales the boxes
+    void draw(const ShaderProgram& shader, const Crowd& crowd, float spacing);
+
+private:
+    unsigned int vao = 0, meshVBO = 0, instanceVBO = 0;
+    std::size_t instanceCapacity = 0;
+    std::vector<float> offsets; // xyz per agent, reused every frame
+};
+
+#endif
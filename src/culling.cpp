@@ -0,0 +1,75 @@
+#include "culling.h"
+#include "simd.h"
+#include <cmath>
+
+Frustum extractFrustum(const glm::mat4& m) {
+    // glm is column-major: m[col][row]; row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum f;
+    f.planes[0] = row3 + row0; // left
+    f.planes[1] = row3 - row0; // right
+    f.planes[2] = row3 + row1; // bottom
+    f.planes[3] = row3 - row1; // top
+    f.planes[4] = row3 + row2; // near
+    f.planes[5] = row3 - row2; // far
+    for (glm::vec4& p : f.planes)
+        p /= glm::length(glm::vec3(p));
+    return f;
+}
+
+void BoxList::clear() {
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void BoxList::add(const glm::vec3& mn, const glm::vec3& mx) {
+    minX.push_back(mn.x); minY.push_back(mn.y); minZ.push_back(mn.z);
+    maxX.push_back(mx.x); maxY.push_back(mx.y); maxZ.push_back(mx.z);
+}
+
+// For each plane only the box corner furthest along the normal matters
+// (the "positive vertex"); if even that corner is behind, the box is out.
+std::size_t cullBoxes(const Frustum& frustum, const BoxList& boxes, uint8_t* visible) {
+    const std::size_t n = boxes.size();
+    std::size_t i = 0, count = 0;
+
+#if defined(MAZE_SIMD_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (const glm::vec4& p : frustum.planes) {
+            __m128 x = _mm_loadu_ps((p.x >= 0.0f ? boxes.maxX : boxes.minX).data() + i);
+            __m128 y = _mm_loadu_ps((p.y >= 0.0f ? boxes.maxY : boxes.minY).data() + i);
+            __m128 z = _mm_loadu_ps((p.z >= 0.0f ? boxes.maxZ : boxes.minZ).data() + i);
+            __m128 d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.x), x),
+                                             _mm_mul_ps(_mm_set1_ps(p.y), y)),
+                                  _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.z), z), _mm_set1_ps(p.w)));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(d, _mm_setzero_ps()));
+        }
+        int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k) {
+            visible[i + k] = (mask >> k) & 1;
+            count += visible[i + k];
+        }
+    }
+#endif
+
+    for (; i < n; ++i) {
+        bool in = true;
+        for (const glm::vec4& p : frustum.planes) {
+            float x = p.x >= 0.0f ? boxes.maxX[i] : boxes.minX[i];
+            float y = p.y >= 0.0f ? boxes.maxY[i] : boxes.minY[i];
+            float z = p.z >= 0.0f ? boxes.maxZ[i] : boxes.minZ[i];
+            if (p.x * x + p.y * y + p.z * z + p.w < 0.0f) {
+                in = false;
+                break;
+            }
+        }
+        visible[i] = in;
+        count += in;
+    }
+    return count;
+}
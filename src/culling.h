@@ -0,0 +1,43 @@
+#ifndef CULLING_H
+#define CULLING_H
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Six planes (left, right, bottom, top, near, far) as (normal, distance),
+// pointing inwards: a point p is inside when dot(n, p) + d >= 0 for all.
+struct Frustum {
+    glm::vec4 planes[6];
+};
+
+// Extract the planes from a projection * view matrix (Gribb/Hartmann)
+Frustum extractFrustum(const glm::mat4& viewProjection);
+
+// Axis-aligned boxes stored as structure-of-arrays for batch testing
+struct BoxList {
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    void clear();
+    void add(const glm::vec3& mn, const glm::vec3& mx);
+    std::size_t size() const { return minX.size(); }
+};
+
+// Write 1 to visible[i] if box i intersects the frustum (conservative),
+// 0 if it is entirely outside one plane. Four boxes are tested per SSE
+// iteration when available. Returns the number of visible boxes.
+std::size_t cullBoxes(const Frustum& frustum, const BoxList& boxes, uint8_t* visible);
+
+// Per-frame culling counters
+struct CullStats {
+    int chunksTested = 0;
+    int chunksDrawn = 0;
+    int cellsTested = 0;  // wall cells in the tested chunks
+    int cellsCulled = 0;  // wall cells in chunks rejected by the frustum
+    int chunksOccluded = 0; // in the frustum but no cell seen by the grid rays
+    int cellsOccluded = 0;  // wall cells in those chunks
+};
+
+#endif
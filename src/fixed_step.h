@@ -0,0 +1,39 @@
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include <cmath>
+
+// Turns variable frame times into whole simulation steps of a fixed length,
+// so movement and collision give the same result at any frame rate. Time
+// that does not fill a step carries over to the next frame, and alpha()
+// says how far between the last two steps the frame is drawn.
+class FixedTimestep {
+public:
+    explicit FixedTimestep(double hz = 120.0, int maxSteps = 12)
+        : dt(1.0 / hz), maxSteps(maxSteps) {}
+
+    // Add a frame's elapsed time; returns how many steps to run now. After a
+    // long stall the backlog is dropped past maxSteps, rather than making
+    // the next frames slower still.
+    int advance(double frameSeconds) {
+        accumulator += frameSeconds;
+        int steps = static_cast<int>(accumulator / dt);
+        if (steps > maxSteps) {
+            steps = maxSteps;
+            accumulator = std::fmod(accumulator, dt) + steps * dt;
+        }
+        accumulator -= steps * dt;
+        return steps;
+    }
+
+    float step() const { return static_cast<float>(dt); }
+    // In [0, 1): 0 draws the previous step's state, 1 would be the latest
+    float alpha() const { return static_cast<float>(accumulator / dt); }
+
+private:
+    double dt;
+    int maxSteps;
+    double accumulator = 0.0;
+};
+
+#endif
@@ -0,0 +1,278 @@
+#include "flowfield.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+
+// Step directions: east, south, west, north
+static const int DC[4] = { 1, 0, -1, 0 };
+static const int DR[4] = { 0, 1, 0, -1 };
+
+static inline uint8_t opposite(int dir) {
+    return static_cast<uint8_t>((dir + 2) & 3);
+}
+
+bool FlowField::reset(const Maze& m, int row, int col) {
+    width = m.width();
+    height = m.height();
+    goalRow = row;
+    goalCol = col;
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+    distances.assign(cells, UNREACHABLE);
+    steps.assign(cells, BLOCKED);
+    visited = 0;
+    seeds.clear();
+
+    if (!m.inBounds(row, col) || m.isWall(row, col)) return false;
+    uint32_t goal = static_cast<uint32_t>(row) * width + col;
+    distances[goal] = 0;
+    steps[goal] = GOAL;
+    seeds.push_back(goal);
+    visited = 1;
+    return true;
+}
+
+void FlowField::build(const Maze& m, int row, int col) {
+    reset(m, row, col);
+    propagate(m);
+}
+
+// Seeds are merged with a FIFO of relaxed cells by distance. Every edge costs
+// one, so cells leave the two lists in distance order, like Dijkstra
+// without a heap.
+void FlowField::propagate(const Maze& m) {
+    queue.clear();
+    std::size_t nextSeed = 0, head = 0;
+    while (nextSeed < seeds.size() || head < queue.size()) {
+        uint32_t cell;
+        if (head == queue.size() ||
+            (nextSeed < seeds.size() && distances[seeds[nextSeed]] <= distances[queue[head]]))
+            cell = seeds[nextSeed++];
+        else
+            cell = queue[head++];
+
+        const uint32_t reach = distances[cell] + 1;
+        const int row = static_cast<int>(cell / width), col = static_cast<int>(cell % width);
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = row + DR[dir], c = col + DC[dir];
+            if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+            uint32_t next = static_cast<uint32_t>(r) * width + c;
+            if (distances[next] <= reach) continue;
+            distances[next] = reach;
+            steps[next] = opposite(dir);
+            queue.push_back(next);
+            ++visited;
+        }
+    }
+}
+
+void FlowField::wallChanged(const Maze& m, int row, int col) {
+    if (row < 0 || row >= height || col < 0 || col >= width) return;
+    const uint32_t cell = static_cast<uint32_t>(row) * width + col;
+    visited = 0;
+    seeds.clear();
+
+    // Best neighbour of an open cell outside the affected region, if any
+    auto attach = [&](uint32_t target) {
+        const int r0 = static_cast<int>(target / width), c0 = static_cast<int>(target % width);
+        uint32_t best = UNREACHABLE;
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = r0 + DR[dir], c = c0 + DC[dir];
+            if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+            uint32_t d = distances[static_cast<uint32_t>(r) * width + c];
+            if (d == UNREACHABLE || d + 1 >= best) continue;
+            best = d + 1;
+            steps[target] = static_cast<uint8_t>(dir);
+        }
+        distances[target] = best;
+        if (best != UNREACHABLE) seeds.push_back(target);
+    };
+
+    if (!m.isWall(row, col)) {
+        // A new opening: nothing routed through it before, so only distances
+        // that it shortens change
+        if (row == goalRow && col == goalCol) {
+            distances[cell] = 0;
+            steps[cell] = GOAL;
+            seeds.push_back(cell);
+        } else {
+            steps[cell] = BLOCKED;
+            attach(cell);
+        }
+        visited = 1;
+        propagate(m);
+        return;
+    }
+
+    if (row == goalRow && col == goalCol) {
+        build(m, goalRow, goalCol);
+        return;
+    }
+    if (distances[cell] == UNREACHABLE) {
+        steps[cell] = BLOCKED;
+        return;
+    }
+
+    // A new wall: every cell whose steps led through it loses its distance
+    region.clear();
+    region.push_back(cell);
+    distances[cell] = UNREACHABLE;
+    steps[cell] = BLOCKED;
+    for (std::size_t i = 0; i < region.size(); ++i) {
+        const int r0 = static_cast<int>(region[i] / width), c0 = static_cast<int>(region[i] % width);
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = r0 + DR[dir], c = c0 + DC[dir];
+            if (!m.inBounds(r, c)) continue;
+            uint32_t next = static_cast<uint32_t>(r) * width + c;
+            if (steps[next] != opposite(dir)) continue;
+            distances[next] = UNREACHABLE;
+            steps[next] = BLOCKED;
+            region.push_back(next);
+        }
+    }
+
+    // Reattach the region from its edges, nearest to the goal first
+    for (std::size_t i = 1; i < region.size(); ++i)
+        attach(region[i]);
+    std::sort(seeds.begin(), seeds.end(),
+              [this](uint32_t a, uint32_t b) { return distances[a] < distances[b]; });
+    visited = region.size();
+    propagate(m);
+}
+
+// --- Parallel build ---
+// Threads wait here between levels; the last to arrive releases the rest
+struct SpinBarrier {
+    explicit SpinBarrier(int count) : count(count) {}
+
+    void wait() {
+        int gen = generation.load(std::memory_order_acquire);
+        if (waiting.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            waiting.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        while (generation.load(std::memory_order_acquire) == gen)
+            std::this_thread::yield();
+    }
+
+    const int count;
+    std::atomic<int> waiting{0};
+    std::atomic<int> generation{0};
+};
+
+// Frontiers below this many cells are expanded by the calling thread alone
+static const std::size_t PARALLEL_FRONTIER = 4096;
+// Cells a thread claims from the frontier at a time
+static const std::size_t FRONTIER_CHUNK = 256;
+
+void FlowField::buildParallel(const Maze& m, int row, int col, int threads) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    if (!reset(m, row, col)) return;
+
+    // A cell belongs to whichever thread first sets its claimed bit; only
+    // that thread writes its distance and step
+    const std::size_t cells = static_cast<std::size_t>(width) * height;
+    std::unique_ptr<std::atomic<uint64_t>[]> claimed(new std::atomic<uint64_t>[(cells + 63) / 64]());
+    claimed[seeds[0] >> 6].store(uint64_t(1) << (seeds[0] & 63), std::memory_order_relaxed);
+
+    auto expand = [&](uint32_t cell, std::vector<uint32_t>& out) {
+        const uint32_t reach = distances[cell] + 1;
+        const int r0 = static_cast<int>(cell / width), c0 = static_cast<int>(cell % width);
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = r0 + DR[dir], c = c0 + DC[dir];
+            if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+            uint32_t next = static_cast<uint32_t>(r) * width + c;
+            std::atomic<uint64_t>& word = claimed[next >> 6];
+            const uint64_t bit = uint64_t(1) << (next & 63);
+            if (word.load(std::memory_order_relaxed) & bit) continue;
+            if (word.fetch_or(bit, std::memory_order_relaxed) & bit) continue;
+            distances[next] = reach;
+            steps[next] = opposite(dir);
+            out.push_back(next);
+        }
+    };
+
+    // Per-thread frontier buffers for the current and next level
+    std::vector<std::vector<uint32_t>> current(threads), next(threads);
+    std::vector<std::size_t> offsets(threads + 1, 0);
+    std::vector<std::size_t> reached(threads, 0);
+    std::vector<uint32_t>& frontier = seeds;
+    std::vector<uint32_t>& serialNext = queue;
+    serialNext.clear();
+
+    while (!frontier.empty()) {
+        if (threads == 1 || frontier.size() < PARALLEL_FRONTIER) {
+            for (uint32_t cell : frontier)
+                expand(cell, serialNext);
+            visited += serialNext.size();
+            frontier.swap(serialNext);
+            serialNext.clear();
+            continue;
+        }
+
+        // Run levels in parallel until the frontier shrinks again. Cells are
+        // numbered across the per-thread buffers by offsets[] and handed out
+        // in chunks.
+        current[0].swap(frontier);
+        for (int t = 1; t < threads; ++t) current[t].clear();
+        offsets[1] = current[0].size();
+        for (int t = 1; t < threads; ++t) offsets[t + 1] = offsets[t];
+        std::atomic<std::size_t> cursor(0);
+        bool keepGoing = true;
+        SpinBarrier barrier(threads);
+
+        auto work = [&](int t) {
+            for (;;) {
+                const std::size_t total = offsets[threads];
+                for (std::size_t start = cursor.fetch_add(FRONTIER_CHUNK); start < total;
+                     start = cursor.fetch_add(FRONTIER_CHUNK)) {
+                    const std::size_t end = std::min(start + FRONTIER_CHUNK, total);
+                    int b = 0;
+                    for (std::size_t i = start; i < end; ++i) {
+                        while (i >= offsets[b + 1]) ++b;
+                        expand(current[b][i - offsets[b]], next[t]);
+                    }
+                }
+                barrier.wait();
+                if (t == 0) {
+                    for (int k = 0; k < threads; ++k) {
+                        reached[k] += next[k].size();
+                        current[k].swap(next[k]);
+                        next[k].clear();
+                        offsets[k + 1] = offsets[k] + current[k].size();
+                    }
+                    cursor.store(0, std::memory_order_relaxed);
+                    keepGoing = offsets[threads] >= PARALLEL_FRONTIER;
+                }
+                barrier.wait();
+                if (!keepGoing) return;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; ++t)
+            pool.emplace_back(work, t);
+        work(0);
+        for (std::thread& t : pool)
+            t.join();
+
+        frontier.clear();
+        for (int t = 0; t < threads; ++t) {
+            frontier.insert(frontier.end(), current[t].begin(), current[t].end());
+            visited += reached[t];
+            reached[t] = 0;
+        }
+    }
+    seeds.clear();
+    queue.clear();
+}
+
+bool FlowField::next(int row, int col, int& nextRow, int& nextCol) const {
+    uint8_t dir = step(row, col);
+    if (dir >= GOAL) return false;
+    nextRow = row + DR[dir];
+    nextCol = col + DC[dir];
+    return true;
+}
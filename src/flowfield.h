@@ -0,0 +1,69 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "maze_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distances and next steps from every cell to one goal, shared by any number
+// of agents: steering is a table lookup instead of a search per agent.
+// Each cell has a step byte (the direction towards the goal, 0 = east,
+// 1 = south, 2 = west, 3 = north, or GOAL / BLOCKED) next to its distance,
+// which the incremental updates need.
+class FlowField {
+public:
+    static constexpr uint8_t GOAL = 4;
+    static constexpr uint8_t BLOCKED = 0xff; // wall, outside, or cut off from the goal
+    static constexpr uint32_t UNREACHABLE = 0xffffffffu;
+
+    // Breadth-first from the goal over every open cell
+    void build(const Maze& m, int goalRow, int goalCol);
+    // Same result as build(), level-synchronous across threads for very
+    // large grids. Levels with a small frontier (long maze corridors) are
+    // expanded on the calling thread, since a barrier per level would cost
+    // more than the level itself. threads = 0 uses every hardware thread.
+    void buildParallel(const Maze& m, int goalRow, int goalCol, int threads = 0);
+
+    // Call after flipping one cell of m with setWall(). Only the cells whose
+    // distance can change are revisited: the cells downstream of a new wall,
+    // or the region a new opening brings closer to the goal.
+    void wallChanged(const Maze& m, int row, int col);
+
+    int gridWidth() const { return width; }
+    int gridHeight() const { return height; }
+    uint8_t step(int row, int col) const {
+        if (row < 0 || row >= height || col < 0 || col >= width) return BLOCKED;
+        return steps[static_cast<std::size_t>(row) * width + col];
+    }
+    uint32_t distance(int row, int col) const {
+        if (row < 0 || row >= height || col < 0 || col >= width) return UNREACHABLE;
+        return distances[static_cast<std::size_t>(row) * width + col];
+    }
+    // The neighbour to move to; returns false at the goal or where the goal
+    // cannot be reached
+    bool next(int row, int col, int& nextRow, int& nextCol) const;
+
+    // Cells whose distance was rewritten by the last build() or wallChanged()
+    std::size_t cellsVisited() const { return visited; }
+    std::size_t memoryBytes() const {
+        return distances.size() * sizeof(uint32_t) + steps.size();
+    }
+
+private:
+    // Size the grid and place the goal; returns false if the goal is blocked
+    bool reset(const Maze& m, int goalRow, int goalCol);
+    // Relax outwards from the cells in seeds (sorted by distance)
+    void propagate(const Maze& m);
+
+    int width = 0, height = 0;
+    int goalRow = -1, goalCol = -1;
+    std::vector<uint32_t> distances;
+    std::vector<uint8_t> steps;
+    std::size_t visited = 0;
+
+    // Scratch reused by every update
+    std::vector<uint32_t> seeds, queue, region;
+};
+
+#endif
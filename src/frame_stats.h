@@ -0,0 +1,39 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+// Frame times collected over a benchmark run, summarised at the end
+class FrameStats {
+public:
+    void add(double milliseconds) { times.push_back(milliseconds); }
+    std::size_t count() const { return times.size(); }
+
+    // Nearest-rank percentile, p in [0, 100]
+    double percentile(double p) const {
+        if (times.empty()) return 0.0;
+        std::vector<double> sorted(times);
+        std::sort(sorted.begin(), sorted.end());
+        std::size_t rank = static_cast<std::size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+    double average() const {
+        double sum = 0.0;
+        for (double t : times) sum += t;
+        return times.empty() ? 0.0 : sum / times.size();
+    }
+
+    void print(const char* label) const {
+        printf("%s: %zu frames, min %.3f ms, avg %.3f ms, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms (%.1f fps)\n",
+               label, times.size(), percentile(0.0), average(), percentile(50.0), percentile(95.0),
+               percentile(99.0), percentile(100.0), average() > 0.0 ? 1000.0 / average() : 0.0);
+    }
+
+private:
+    std::vector<double> times;
+};
+
+#endif
@@ -0,0 +1,328 @@
+#include "generator.h"
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+// Room neighbours: east, south, west, north
+static const int DX[4] = { 1, 0, -1, 0 };
+static const int DY[4] = { 0, 1, 0, -1 };
+
+// Fill the grid with walls; rooms are carved as they join the maze
+static void resetGrid(Maze& m, int cellsX, int cellsY) {
+    m.resize(2 * cellsX + 1, 2 * cellsY + 1, true);
+}
+
+static void carveRoom(Maze& m, int x, int y) {
+    m.setWall(2 * y + 1, 2 * x + 1, false);
+}
+
+// Open the wall between room (x, y) and its neighbour in direction dir
+static void carvePassage(Maze& m, int x, int y, int dir) {
+    m.setWall(2 * y + 1 + DY[dir], 2 * x + 1 + DX[dir], false);
+}
+
+const char* algorithmName(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+    case MazeAlgorithm::Backtracker: return "backtracker";
+    case MazeAlgorithm::Kruskal:     return "kruskal";
+    case MazeAlgorithm::Wilson:      return "wilson";
+    case MazeAlgorithm::Prim:        return "prim";
+    }
+    return "unknown";
+}
+
+bool parseAlgorithm(const char* name, MazeAlgorithm& out) {
+    const MazeAlgorithm all[] = { MazeAlgorithm::Backtracker, MazeAlgorithm::Kruskal,
+                                  MazeAlgorithm::Wilson, MazeAlgorithm::Prim };
+    for (MazeAlgorithm a : all) {
+        if (std::strcmp(name, algorithmName(a)) == 0) {
+            out = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Recursive backtracker (iterative, explicit stack) ---
+void generateBacktracker(Maze& m, int cellsX, int cellsY, uint64_t seed) {
+    resetGrid(m, cellsX, cellsY);
+    if (cellsX <= 0 || cellsY <= 0) return;
+    MazeRng rng(seed);
+
+    std::vector<uint8_t> visited(static_cast<std::size_t>(cellsX) * cellsY, 0);
+    std::vector<int> stack;
+    stack.reserve(1024);
+
+    int start = static_cast<int>(rng.below(static_cast<uint32_t>(cellsX * cellsY)));
+    visited[start] = 1;
+    carveRoom(m, start % cellsX, start / cellsX);
+    stack.push_back(start);
+
+    while (!stack.empty()) {
+        int cell = stack.back();
+        int x = cell % cellsX, y = cell / cellsX;
+
+        int options[4], count = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = x + DX[dir], ny = y + DY[dir];
+            if (nx < 0 || nx >= cellsX || ny < 0 || ny >= cellsY) continue;
+            if (!visited[ny * cellsX + nx]) options[count++] = dir;
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+
+        int dir = options[rng.below(count)];
+        int next = (y + DY[dir]) * cellsX + (x + DX[dir]);
+        visited[next] = 1;
+        carveRoom(m, x + DX[dir], y + DY[dir]);
+        carvePassage(m, x, y, dir);
+        stack.push_back(next);
+    }
+}
+
+// --- Randomized Kruskal with union-find ---
+// Path halving plus union by size keeps every find effectively constant time.
+static int findRoot(std::vector<int>& parent, int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void generateKruskal(Maze& m, int cellsX, int cellsY, uint64_t seed) {
+    resetGrid(m, cellsX, cellsY);
+    if (cellsX <= 0 || cellsY <= 0) return;
+    MazeRng rng(seed);
+
+    const int total = cellsX * cellsY;
+    for (int y = 0; y < cellsY; ++y)
+        for (int x = 0; x < cellsX; ++x)
+            carveRoom(m, x, y);
+
+    // Edge id = cell * 2 + (0 = east, 1 = south)
+    std::vector<uint32_t> edges;
+    edges.reserve(static_cast<std::size_t>(total) * 2);
+    for (int y = 0; y < cellsY; ++y) {
+        for (int x = 0; x < cellsX; ++x) {
+            uint32_t cell = static_cast<uint32_t>(y * cellsX + x);
+            if (x + 1 < cellsX) edges.push_back(cell * 2);
+            if (y + 1 < cellsY) edges.push_back(cell * 2 + 1);
+        }
+    }
+    for (std::size_t i = edges.size(); i > 1; --i)
+        std::swap(edges[i - 1], edges[rng.below(static_cast<uint32_t>(i))]);
+
+    std::vector<int> parent(total), size(total, 1);
+    std::iota(parent.begin(), parent.end(), 0);
+
+    int joined = 1;
+    for (uint32_t edge : edges) {
+        int cell = static_cast<int>(edge >> 1);
+        int dir = (edge & 1) ? 1 : 0; // south : east
+        int other = cell + (dir == 0 ? 1 : cellsX);
+
+        int a = findRoot(parent, cell), b = findRoot(parent, other);
+        if (a == b) continue;
+        if (size[a] < size[b]) std::swap(a, b);
+        parent[b] = a;
+        size[a] += size[b];
+        carvePassage(m, cell % cellsX, cell / cellsX, dir);
+        if (++joined == total) break;
+    }
+}
+
+// --- Wilson's algorithm (loop-erased random walks) ---
+// Produces a uniform spanning tree; the walk remembers only the last
+// direction taken out of each cell, which erases loops implicitly.
+void generateWilson(Maze& m, int cellsX, int cellsY, uint64_t seed) {
+    resetGrid(m, cellsX, cellsY);
+    if (cellsX <= 0 || cellsY <= 0) return;
+    MazeRng rng(seed);
+
+    const int total = cellsX * cellsY;
+    std::vector<uint8_t> inTree(total, 0);
+    std::vector<uint8_t> walkDir(total, 0);
+
+    int root = static_cast<int>(rng.below(static_cast<uint32_t>(total)));
+    inTree[root] = 1;
+    carveRoom(m, root % cellsX, root / cellsX);
+
+    for (int start = 0; start < total; ++start) {
+        if (inTree[start]) continue;
+
+        // Random walk until the tree is hit
+        int cell = start;
+        while (!inTree[cell]) {
+            int x = cell % cellsX, y = cell / cellsX;
+            int dir;
+            int nx, ny;
+            do {
+                dir = static_cast<int>(rng.below(4));
+                nx = x + DX[dir];
+                ny = y + DY[dir];
+            } while (nx < 0 || nx >= cellsX || ny < 0 || ny >= cellsY);
+            walkDir[cell] = static_cast<uint8_t>(dir);
+            cell = ny * cellsX + nx;
+        }
+
+        // Retrace the loop-erased path and add it to the tree
+        cell = start;
+        while (!inTree[cell]) {
+            int x = cell % cellsX, y = cell / cellsX;
+            int dir = walkDir[cell];
+            inTree[cell] = 1;
+            carveRoom(m, x, y);
+            carvePassage(m, x, y, dir);
+            cell = (y + DY[dir]) * cellsX + (x + DX[dir]);
+        }
+    }
+}
+
+// --- Randomized Prim's algorithm ---
+void generatePrim(Maze& m, int cellsX, int cellsY, uint64_t seed) {
+    resetGrid(m, cellsX, cellsY);
+    if (cellsX <= 0 || cellsY <= 0) return;
+    MazeRng rng(seed);
+
+    // 0 = untouched, 1 = frontier, 2 = in maze
+    std::vector<uint8_t> state(static_cast<std::size_t>(cellsX) * cellsY, 0);
+    std::vector<int> frontier;
+    frontier.reserve(1024);
+
+    auto addRoom = [&](int x, int y) {
+        state[y * cellsX + x] = 2;
+        carveRoom(m, x, y);
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = x + DX[dir], ny = y + DY[dir];
+            if (nx < 0 || nx >= cellsX || ny < 0 || ny >= cellsY) continue;
+            uint8_t& s = state[ny * cellsX + nx];
+            if (s == 0) {
+                s = 1;
+                frontier.push_back(ny * cellsX + nx);
+            }
+        }
+    };
+
+    int start = static_cast<int>(rng.below(static_cast<uint32_t>(cellsX * cellsY)));
+    addRoom(start % cellsX, start / cellsX);
+
+    while (!frontier.empty()) {
+        std::size_t pick = rng.below(static_cast<uint32_t>(frontier.size()));
+        int cell = frontier[pick];
+        frontier[pick] = frontier.back();
+        frontier.pop_back();
+
+        int x = cell % cellsX, y = cell / cellsX;
+        int options[4], count = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            int nx = x + DX[dir], ny = y + DY[dir];
+            if (nx < 0 || nx >= cellsX || ny < 0 || ny >= cellsY) continue;
+            if (state[ny * cellsX + nx] == 2) options[count++] = dir;
+        }
+        carvePassage(m, x, y, options[rng.below(count)]);
+        addRoom(x, y);
+    }
+}
+
+void generateMaze(Maze& m, int cellsX, int cellsY, MazeAlgorithm algorithm, uint64_t seed) {
+    switch (algorithm) {
+    case MazeAlgorithm::Backtracker: generateBacktracker(m, cellsX, cellsY, seed); break;
+    case MazeAlgorithm::Kruskal:     generateKruskal(m, cellsX, cellsY, seed); break;
+    case MazeAlgorithm::Wilson:      generateWilson(m, cellsX, cellsY, seed); break;
+    case MazeAlgorithm::Prim:        generatePrim(m, cellsX, cellsY, seed); break;
+    }
+    if (cellsX <= 0 || cellsY <= 0) return;
+    m.setWall(0, 1, false);
+    m.setWall(m.height() - 1, m.width() - 2, false);
+}
+
+// --- EllerGenerator ---
+EllerGenerator::EllerGenerator(int cellsX, uint64_t seed)
+    : cellsX(cellsX), rng(seed), sets(cellsX, -1), parent(2 * cellsX),
+      remaining(2 * cellsX), relabel(2 * cellsX), hasDown(2 * cellsX), down(cellsX) {}
+
+int EllerGenerator::findSet(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];
+        label = parent[label];
+    }
+    return label;
+}
+
+void EllerGenerator::nextRow(Maze& m, int row) {
+    if (emitted == 0) {
+        // Top border with the entrance
+        for (int c = 0; c < m.width(); ++c)
+            m.setWall(row, c, c != 1);
+    } else if (emitted % 2 == 1) {
+        emitRoomRow(m, row);
+    } else {
+        emitWallRow(m, row);
+    }
+    ++emitted;
+}
+
+// Join horizontal neighbours in different sets at random
+void EllerGenerator::emitRoomRow(Maze& m, int row) {
+    // Carried-down cells hold labels < cellsX; fresh cells take the rest
+    int nextLabel = 0;
+    for (int x = 0; x < cellsX; ++x)
+        if (sets[x] >= nextLabel) nextLabel = sets[x] + 1;
+    for (int x = 0; x < cellsX; ++x)
+        if (sets[x] < 0) sets[x] = nextLabel++;
+    for (int i = 0; i < nextLabel; ++i) parent[i] = i;
+
+    for (int c = 0; c < m.width(); ++c)
+        m.setWall(row, c, (c & 1) == 0);
+
+    for (int x = 0; x + 1 < cellsX; ++x) {
+        int a = findSet(sets[x]), b = findSet(sets[x + 1]);
+        if (a != b && (rng.next() >> 63)) {
+            parent[b] = a;
+            m.setWall(row, 2 * x + 2, false);
+        }
+    }
+    for (int x = 0; x < cellsX; ++x)
+        sets[x] = findSet(sets[x]);
+}
+
+// Every set continues into the next row through at least one passage
+void EllerGenerator::emitWallRow(Maze& m, int row) {
+    for (int x = 0; x < cellsX; ++x) {
+        remaining[sets[x]] = 0;
+        hasDown[sets[x]] = 0;
+    }
+    for (int x = 0; x < cellsX; ++x)
+        ++remaining[sets[x]];
+
+    for (int c = 0; c < m.width(); ++c)
+        m.setWall(row, c, true);
+
+    for (int x = 0; x < cellsX; ++x) {
+        int set = sets[x];
+        bool go = (rng.next() >> 63) != 0;
+        if (--remaining[set] == 0 && !hasDown[set]) go = true;
+        down[x] = go;
+        if (go) {
+            hasDown[set] = 1;
+            m.setWall(row, 2 * x + 1, false);
+        }
+    }
+
+    // Compact the surviving labels into [0, cellsX) for the next row
+    for (int x = 0; x < cellsX; ++x) relabel[sets[x]] = -1;
+    int label = 0;
+    for (int x = 0; x < cellsX; ++x) {
+        if (!down[x]) {
+            sets[x] = -1;
+            continue;
+        }
+        int& mapped = relabel[sets[x]];
+        if (mapped < 0) mapped = label++;
+        sets[x] = mapped;
+    }
+}
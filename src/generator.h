@@ -0,0 +1,83 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include "maze_grid.h"
+#include <cstdint>
+#include <vector>
+
+// Small, fast xorshift64* generator so results are identical on every platform
+struct MazeRng {
+    uint64_t state;
+
+    explicit MazeRng(uint64_t seed) : state(seed * 0x9E3779B97F4A7C15ull + 1) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1Dull;
+    }
+    // Uniform integer in [0, n)
+    uint32_t below(uint32_t n) {
+        return static_cast<uint32_t>(((next() >> 32) * n) >> 32);
+    }
+};
+
+enum class MazeAlgorithm { Backtracker, Kruskal, Wilson, Prim };
+
+const char* algorithmName(MazeAlgorithm algorithm);
+// Accepts the names returned by algorithmName(); returns false if unknown
+bool parseAlgorithm(const char* name, MazeAlgorithm& out);
+
+// --- Perfect maze generators ---
+// Each one carves a maze of cellsX x cellsY rooms into m, which is resized
+// to (2 * cellsX + 1) x (2 * cellsY + 1) grid cells: rooms sit on odd
+// rows/columns and the cells between them are walls or passages.
+// The same seed always produces the same maze.
+void generateBacktracker(Maze& m, int cellsX, int cellsY, uint64_t seed);
+void generateKruskal(Maze& m, int cellsX, int cellsY, uint64_t seed);
+void generateWilson(Maze& m, int cellsX, int cellsY, uint64_t seed);
+void generatePrim(Maze& m, int cellsX, int cellsY, uint64_t seed);
+
+// Dispatch to one of the above, then open an entrance in the first row
+// (column 1) and an exit in the last row (column width - 2).
+void generateMaze(Maze& m, int cellsX, int cellsY, MazeAlgorithm algorithm, uint64_t seed);
+
+// --- Eller's algorithm, streamed one grid row at a time ---
+// Keeps only O(cellsX) state, so an endless maze can be produced as the
+// player walks without memory growing. Rows use the same layout as the
+// generators above (grid width 2 * cellsX + 1): the first row is the top
+// border with an entrance at column 1, then room rows and the wall rows
+// between them alternate forever. No loops are ever created, and every
+// region of rooms has a passage into the next row, so everything above
+// the player is reachable from further down the corridor.
+class EllerGenerator {
+public:
+    EllerGenerator(int cellsX, uint64_t seed);
+
+    int gridWidth() const { return 2 * cellsX + 1; }
+    // Write the next grid row into row `row` of m (m.width() must equal gridWidth())
+    void nextRow(Maze& m, int row);
+    // Grid rows emitted so far
+    long long rowsEmitted() const { return emitted; }
+
+private:
+    void emitRoomRow(Maze& m, int row);
+    void emitWallRow(Maze& m, int row);
+    int findSet(int label);
+
+    int cellsX;
+    MazeRng rng;
+    long long emitted = 0;
+
+    // Per-column set label for the current room row (-1 = not yet assigned)
+    std::vector<int> sets;
+    // Scratch, all sized 2 * cellsX and reused for every row
+    std::vector<int> parent;
+    std::vector<int> remaining;
+    std::vector<int> relabel;
+    std::vector<uint8_t> hasDown;
+    std::vector<uint8_t> down;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#ifndef GL_STATS_H
+#define GL_STATS_H
+
+#include <cstddef>
+#include <cstdio>
+
+// Per-frame counts of the GL calls that cost driver time: draws, uniform
+// and buffer updates, binds and other state changes. Include after the GL
+// headers (GLEW or GLUT); with GLUT, glutSolidCube() is counted as a draw.
+// When built with -DMAZE_GL_STATS the entry points below are redirected
+// through counting wrappers in every file including this header; without
+// it nothing is intercepted and the counts stay zero.
+struct GlCallCounts {
+    unsigned drawCalls = 0;
+    unsigned long long vertices = 0;   // per instance, plus glVertex calls
+    unsigned beginEndPairs = 0;
+    unsigned uniformUpdates = 0;
+    unsigned bufferUploads = 0;
+    std::size_t uploadBytes = 0;
+    unsigned programBinds = 0, vaoBinds = 0, bufferBinds = 0;
+    unsigned redundantBinds = 0;       // program or VAO already bound
+    unsigned stateToggles = 0;         // glEnable / glDisable / glBlendFunc
+    unsigned fixedStateChanges = 0;    // matrix, colour and light calls
+};
+
+class GlCallStats {
+public:
+#if defined(MAZE_GL_STATS)
+    static constexpr bool ENABLED = true;
+#else
+    static constexpr bool ENABLED = false;
+#endif
+
+    static GlCallCounts& current() { return frame; }
+    static const GlCallCounts& lastFrame() { return last; }
+    // Call once per frame, after the swap
+    static void endFrame() {
+        last = frame;
+        frame = GlCallCounts();
+    }
+
+    static void format(const GlCallCounts& c, char* text, std::size_t size) {
+        std::snprintf(text, size,
+                      "draws %u (%llu verts), begin/end %u, uniforms %u, uploads %u (%.1f KB), "
+                      "binds program %u vao %u buffer %u (%u redundant), toggles %u, "
+                      "matrix/colour/light %u",
+                      c.drawCalls, c.vertices, c.beginEndPairs, c.uniformUpdates, c.bufferUploads,
+                      c.uploadBytes / 1024.0, c.programBinds, c.vaoBinds, c.bufferBinds,
+                      c.redundantBinds, c.stateToggles, c.fixedStateChanges);
+    }
+
+    // Last object bound, to spot binds that change nothing
+    static inline unsigned boundProgram = 0, boundVao = 0;
+
+private:
+    static inline GlCallCounts frame, last;
+};
+
+#if defined(MAZE_GL_STATS)
+// --- Counting wrappers ---
+// Each wrapper calls the real entry point, then the name is redefined so
+// later code in the file goes through the wrapper.
+
+inline void glStatsDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    ++GlCallStats::current().drawCalls;
+    GlCallStats::current().vertices += count;
+    glDrawArrays(mode, first, count);
+}
+#define glDrawArrays glStatsDrawArrays
+
+// Immediate mode: each glBegin/glEnd pair is one draw
+inline void glStatsEnd() {
+    ++GlCallStats::current().beginEndPairs;
+    ++GlCallStats::current().drawCalls;
+    glEnd();
+}
+inline void glStatsVertex3f(GLfloat x, GLfloat y, GLfloat z) {
+    ++GlCallStats::current().vertices;
+    glVertex3f(x, y, z);
+}
+#define glEnd glStatsEnd
+#define glVertex3f glStatsVertex3f
+
+inline void glStatsEnable(GLenum cap) {
+    ++GlCallStats::current().stateToggles;
+    glEnable(cap);
+}
+inline void glStatsDisable(GLenum cap) {
+    ++GlCallStats::current().stateToggles;
+    glDisable(cap);
+}
+inline void glStatsBlendFunc(GLenum src, GLenum dst) {
+    ++GlCallStats::current().stateToggles;
+    glBlendFunc(src, dst);
+}
+#define glEnable glStatsEnable
+#define glDisable glStatsDisable
+#define glBlendFunc glStatsBlendFunc
+
+// Fixed-function state: new_main.cpp sets these around every cube it draws
+inline void glStatsPushMatrix() {
+    ++GlCallStats::current().fixedStateChanges;
+    glPushMatrix();
+}
+inline void glStatsPopMatrix() {
+    ++GlCallStats::current().fixedStateChanges;
+    glPopMatrix();
+}
+inline void glStatsLoadIdentity() {
+    ++GlCallStats::current().fixedStateChanges;
+    glLoadIdentity();
+}
+inline void glStatsTranslatef(GLfloat x, GLfloat y, GLfloat z) {
+    ++GlCallStats::current().fixedStateChanges;
+    glTranslatef(x, y, z);
+}
+inline void glStatsScalef(GLfloat x, GLfloat y, GLfloat z) {
+    ++GlCallStats::current().fixedStateChanges;
+    glScalef(x, y, z);
+}
+inline void glStatsRotatef(GLfloat angle, GLfloat x, GLfloat y, GLfloat z) {
+    ++GlCallStats::current().fixedStateChanges;
+    glRotatef(angle, x, y, z);
+}
+inline void glStatsColor3f(GLfloat r, GLfloat g, GLfloat b) {
+    ++GlCallStats::current().fixedStateChanges;
+    glColor3f(r, g, b);
+}
+inline void glStatsColor4f(GLfloat r, GLfloat g, GLfloat b, GLfloat a) {
+    ++GlCallStats::current().fixedStateChanges;
+    glColor4f(r, g, b, a);
+}
+inline void glStatsLightfv(GLenum light, GLenum name, const GLfloat* params) {
+    ++GlCallStats::current().fixedStateChanges;
+    glLightfv(light, name, params);
+}
+#define glPushMatrix glStatsPushMatrix
+#define glPopMatrix glStatsPopMatrix
+#define glLoadIdentity glStatsLoadIdentity
+#define glTranslatef glStatsTranslatef
+#define glScalef glStatsScalef
+#define glRotatef glStatsRotatef
+#define glColor3f glStatsColor3f
+#define glColor4f glStatsColor4f
+#define glLightfv glStatsLightfv
+
+#if defined(GLUT_API_VERSION)
+// GLUT draws a solid cube as six quads: one draw of 24 vertices
+inline void glStatsSolidCube(double size) {
+    ++GlCallStats::current().drawCalls;
+    GlCallStats::current().vertices += 24;
+    glutSolidCube(size);
+}
+#define glutSolidCube glStatsSolidCube
+#endif
+
+#if defined(__glew_h__)
+// Core-profile entry points, which GLEW defines as macros over its
+// function pointers
+inline void glStatsDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    ++GlCallStats::current().drawCalls;
+    GlCallStats::current().vertices += static_cast<unsigned long long>(count) * instances;
+    glDrawArraysInstanced(mode, first, count, instances);
+}
+inline void glStatsUseProgram(GLuint program) {
+    ++GlCallStats::current().programBinds;
+    if (program == GlCallStats::boundProgram) ++GlCallStats::current().redundantBinds;
+    GlCallStats::boundProgram = program;
+    glUseProgram(program);
+}
+inline void glStatsBindVertexArray(GLuint vao) {
+    ++GlCallStats::current().vaoBinds;
+    if (vao == GlCallStats::boundVao) ++GlCallStats::current().redundantBinds;
+    GlCallStats::boundVao = vao;
+    glBindVertexArray(vao);
+}
+inline void glStatsBindBuffer(GLenum target, GLuint buffer) {
+    ++GlCallStats::current().bufferBinds;
+    glBindBuffer(target, buffer);
+}
+inline void glStatsBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage) {
+    ++GlCallStats::current().bufferUploads;
+    GlCallStats::current().uploadBytes += size;
+    glBufferData(target, size, data, usage);
+}
+inline void glStatsBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data) {
+    ++GlCallStats::current().bufferUploads;
+    GlCallStats::current().uploadBytes += size;
+    glBufferSubData(target, offset, size, data);
+}
+inline void glStatsUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    ++GlCallStats::current().uniformUpdates;
+    glUniformMatrix3fv(location, count, transpose, value);
+}
+inline void glStatsUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+    ++GlCallStats::current().uniformUpdates;
+    glUniformMatrix4fv(location, count, transpose, value);
+}
+#undef glDrawArraysInstanced
+#undef glUseProgram
+#undef glBindVertexArray
+#undef glBindBuffer
+#undef glBufferData
+#undef glBufferSubData
+#undef glUniformMatrix3fv
+#undef glUniformMatrix4fv
+#define glDrawArraysInstanced glStatsDrawArraysInstanced
+#define glUseProgram glStatsUseProgram
+#define glBindVertexArray glStatsBindVertexArray
+#define glBindBuffer glStatsBindBuffer
+#define glBufferData glStatsBufferData
+#define glBufferSubData glStatsBufferSubData
+#define glUniformMatrix3fv glStatsUniformMatrix3fv
+#define glUniformMatrix4fv glStatsUniformMatrix4fv
+#endif
+
+#endif
+
+#endif
@@ -0,0 +1,61 @@
+#include "gpu_timer.h"
+#include "profiler.h"
+
+void GpuTimer::create() {
+    GLint bits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+    supported = bits > 0;
+    if (!supported)
+        return;
+    for (FrameQueries& frame : frames) {
+        glGenQueries(MAX_SECTIONS, frame.queries);
+        frame.sections.reserve(MAX_SECTIONS);
+    }
+}
+
+void GpuTimer::destroy() {
+    if (!supported)
+        return;
+    for (FrameQueries& frame : frames) {
+        glDeleteQueries(MAX_SECTIONS, frame.queries);
+        frame.sections.clear();
+    }
+    supported = false;
+}
+
+void GpuTimer::beginFrame() {
+    if (!supported)
+        return;
+    current ^= 1;
+    FrameQueries& frame = frames[current];
+    if (!frame.sections.empty()) {
+        // Queries finish in order, so the last one being ready means all are
+        GLint ready = 0;
+        glGetQueryObjectiv(frame.queries[frame.sections.size() - 1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (ready && Profiler::enabled()) {
+            ProfileRing& ring = Profiler::namedRing("GPU");
+            for (std::size_t i = 0; i < frame.sections.size(); ++i) {
+                GLuint64 elapsed = 0;
+                glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed);
+                ring.push({ frame.sections[i].name, frame.sections[i].cpuStartNs, elapsed });
+            }
+        }
+    }
+    frame.sections.clear();
+}
+
+void GpuTimer::begin(const char* name) {
+    FrameQueries& frame = frames[current];
+    if (!supported || !Profiler::enabled() || open || frame.sections.size() == MAX_SECTIONS)
+        return;
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[frame.sections.size()]);
+    frame.sections.push_back({ name, Profiler::now() });
+    open = true;
+}
+
+void GpuTimer::end() {
+    if (!open)
+        return;
+    glEndQuery(GL_TIME_ELAPSED);
+    open = false;
+}
@@ -0,0 +1,44 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <vector>
+
+// GL_TIME_ELAPSED queries around sections of a frame, reported on the
+// profiler's "GPU" timeline. Two sets of queries alternate between frames
+// and results are only read once the driver says they are available, so
+// timing never stalls the pipeline; a frame whose results are late is
+// dropped instead. Sections cannot nest (one elapsed query at a time).
+class GpuTimer {
+public:
+    // Does nothing if the driver has no timer queries
+    void create();
+    void destroy();
+
+    // Collect the frame before last and start recording into its queries
+    void beginFrame();
+    void begin(const char* name);
+    void end();
+
+    bool available() const { return supported; }
+
+private:
+    static const int MAX_SECTIONS = 16;
+
+    struct Section {
+        const char* name;
+        uint64_t cpuStartNs; // places the GPU time on the trace
+    };
+    struct FrameQueries {
+        GLuint queries[MAX_SECTIONS] = {};
+        std::vector<Section> sections;
+    };
+
+    FrameQueries frames[2];
+    int current = 0;
+    bool supported = false;
+    bool open = false;
+};
+
+#endif
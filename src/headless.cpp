@@ -0,0 +1,146 @@
+#include "headless.h"
+#include <iostream>
+
+#if defined(MAZE_HEADLESS)
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+// Framebuffer object entry points, loaded once a context is current
+static PFNGLGENRENDERBUFFERSPROC genRenderbuffers;
+static PFNGLBINDRENDERBUFFERPROC bindRenderbuffer;
+static PFNGLRENDERBUFFERSTORAGEPROC renderbufferStorage;
+static PFNGLDELETERENDERBUFFERSPROC deleteRenderbuffers;
+static PFNGLGENFRAMEBUFFERSPROC genFramebuffers;
+static PFNGLBINDFRAMEBUFFERPROC bindFramebuffer;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer;
+static PFNGLCHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus;
+static PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers;
+
+template <class Proc>
+static bool loadProc(Proc& proc, const char* name) {
+    proc = reinterpret_cast<Proc>(eglGetProcAddress(name));
+    return proc != nullptr;
+}
+
+bool HeadlessContext::createContext(bool compatibility) {
+    // Prefer Mesa's surfaceless platform, which needs no X or Wayland server
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay)
+        dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (dpy == EGL_NO_DISPLAY)
+        dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major = 0, minor = 0;
+    if (dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor)) {
+        std::cerr << "Headless: no EGL display\n";
+        return false;
+    }
+    display = dpy;
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(dpy, configAttribs, &config, 1, &configCount) || configCount == 0) {
+        std::cerr << "Headless: no EGL config with desktop OpenGL\n";
+        return false;
+    }
+
+    const EGLint coreAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    const EGLint compatibilityAttribs[] = {
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        EGL_NONE
+    };
+    eglBindAPI(EGL_OPENGL_API);
+    EGLContext ctx = eglCreateContext(dpy, config, EGL_NO_CONTEXT,
+                                      compatibility ? compatibilityAttribs : coreAttribs);
+    if (ctx == EGL_NO_CONTEXT) {
+        std::cerr << (compatibility ? "Headless: could not create an OpenGL compatibility context\n"
+                                    : "Headless: could not create an OpenGL 3.3 core context\n");
+        return false;
+    }
+    context = ctx;
+
+    // Surfaceless: everything is drawn into the framebuffer object
+    if (!eglMakeCurrent(dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, ctx)) {
+        std::cerr << "Headless: EGL_KHR_surfaceless_context is not supported\n";
+        return false;
+    }
+
+    if (!loadProc(genRenderbuffers, "glGenRenderbuffers") || !loadProc(bindRenderbuffer, "glBindRenderbuffer") ||
+        !loadProc(renderbufferStorage, "glRenderbufferStorage") ||
+        !loadProc(deleteRenderbuffers, "glDeleteRenderbuffers") ||
+        !loadProc(genFramebuffers, "glGenFramebuffers") || !loadProc(bindFramebuffer, "glBindFramebuffer") ||
+        !loadProc(framebufferRenderbuffer, "glFramebufferRenderbuffer") ||
+        !loadProc(checkFramebufferStatus, "glCheckFramebufferStatus") ||
+        !loadProc(deleteFramebuffers, "glDeleteFramebuffers")) {
+        std::cerr << "Headless: framebuffer objects are not supported\n";
+        return false;
+    }
+    return true;
+}
+
+bool HeadlessContext::createFramebuffer(int width, int height) {
+    fbWidth = width;
+    fbHeight = height;
+
+    genRenderbuffers(1, &colorBuffer);
+    bindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    genRenderbuffers(1, &depthBuffer);
+    bindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+
+    genFramebuffers(1, &fbo);
+    bindFramebuffer(GL_FRAMEBUFFER, fbo);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    if (checkFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "Headless: offscreen framebuffer is incomplete\n";
+        return false;
+    }
+    glViewport(0, 0, width, height);
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (context) {
+        if (fbo) deleteFramebuffers(1, &fbo);
+        if (colorBuffer) deleteRenderbuffers(1, &colorBuffer);
+        if (depthBuffer) deleteRenderbuffers(1, &depthBuffer);
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(display, context);
+    }
+    if (display)
+        eglTerminate(display);
+    fbo = colorBuffer = depthBuffer = 0;
+    context = display = nullptr;
+}
+
+#else
+
+bool HeadlessContext::createContext(bool) {
+    std::cerr << "Headless mode needs a build with -DMAZE_HEADLESS and -lEGL\n";
+    return false;
+}
+
+bool HeadlessContext::createFramebuffer(int, int) {
+    return false;
+}
+
+void HeadlessContext::destroy() {
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+// Offscreen OpenGL context for benchmark runs on machines without a
+// display or GPU (e.g. Mesa llvmpipe). The context is created on EGL's
+// surfaceless platform, and frames are drawn into a framebuffer object
+// instead of a window. The framebuffer entry points are loaded through
+// EGL, so no GL loader is needed.
+//
+// Needs EGL at build time: compile with -DMAZE_HEADLESS and link -lEGL.
+// Without it, createContext() reports that headless mode is unavailable.
+class HeadlessContext {
+public:
+    ~HeadlessContext() { destroy(); }
+
+    // Create the context and make it current: OpenGL 3.3 core, or a
+    // compatibility profile for fixed-function drawing (new_main.cpp)
+    bool createContext(bool compatibility = false);
+    // Create and bind the offscreen framebuffer
+    bool createFramebuffer(int width, int height);
+    void destroy();
+
+    int width() const { return fbWidth; }
+    int height() const { return fbHeight; }
+
+private:
+    void* display = nullptr;
+    void* context = nullptr;
+    unsigned int fbo = 0, colorBuffer = 0, depthBuffer = 0;
+    int fbWidth = 0, fbHeight = 0;
+};
+
+#endif
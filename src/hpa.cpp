@@ -0,0 +1,482 @@
+#include "hpa.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+static const uint16_t NO_PATH = 0xffff;
+static const uint32_t UNREACHED = 0xffffffffu;
+// Openings at least this wide get an entrance at each end, and one every
+// ENTRANCE_SPACING cells between, instead of one in the middle
+static const int WIDE_ENTRANCE = 6;
+static const int ENTRANCE_SPACING = 8;
+
+// Neighbour directions: east, south, west, north
+static const int DC[4] = { 1, 0, -1, 0 };
+static const int DR[4] = { 0, 1, 0, -1 };
+
+int HierarchicalPlanner::clusterOf(uint32_t cell) const {
+    int row = static_cast<int>(cell / width), col = static_cast<int>(cell % width);
+    return (row / clusterSize) * clustersX + col / clusterSize;
+}
+
+void HierarchicalPlanner::clusterBounds(int cluster, int& row0, int& col0, int& rows, int& cols) const {
+    row0 = (cluster / clustersX) * clusterSize;
+    col0 = (cluster % clustersX) * clusterSize;
+    rows = std::min(clusterSize, height - row0);
+    cols = std::min(clusterSize, width - col0);
+}
+
+bool HierarchicalPlanner::clustersTouch(int a, int b) const {
+    return std::abs(a / clustersX - b / clustersX) <= 1 && std::abs(a % clustersX - b % clustersX) <= 1;
+}
+
+void HierarchicalPlanner::searchWindow(const Maze& m, uint32_t cell, int a, int b, WindowSearch& s) const {
+    const std::size_t area = static_cast<std::size_t>(4) * clusterSize * clusterSize;
+    if (s.stamp.size() != area) {
+        s.distance.assign(area, 0);
+        s.stamp.assign(area, 0);
+        s.parent.assign(area, 0);
+        s.generation = 0;
+    }
+    ++s.generation;
+
+    int row0, col0, rows, cols, row1, col1, rowsB, colsB;
+    clusterBounds(a, row0, col0, rows, cols);
+    clusterBounds(b, row1, col1, rowsB, colsB);
+    s.row0 = std::min(row0, row1);
+    s.col0 = std::min(col0, col1);
+    s.rows = std::max(row0 + rows, row1 + rowsB) - s.row0;
+    s.cols = std::max(col0 + cols, col1 + colsB) - s.col0;
+
+    const uint16_t first = static_cast<uint16_t>((cell / width - s.row0) * s.cols + (cell % width - s.col0));
+    s.stamp[first] = s.generation;
+    s.distance[first] = 0;
+    s.queue.clear();
+    s.queue.push_back(first);
+
+    for (std::size_t head = 0; head < s.queue.size(); ++head) {
+        const uint16_t local = s.queue[head];
+        const int lr = local / s.cols, lc = local % s.cols;
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = lr + DR[dir], c = lc + DC[dir];
+            if (r < 0 || r >= s.rows || c < 0 || c >= s.cols) continue;
+            if (m.isWall(s.row0 + r, s.col0 + c)) continue;
+            const uint16_t next = static_cast<uint16_t>(r * s.cols + c);
+            if (s.stamp[next] == s.generation) continue;
+            s.stamp[next] = s.generation;
+            s.distance[next] = static_cast<uint16_t>(s.distance[local] + 1);
+            s.parent[next] = static_cast<uint8_t>(dir);
+            s.queue.push_back(next);
+        }
+    }
+}
+
+// Distance to a cell of the window last searched, NO_PATH if it was not reached
+uint16_t HierarchicalPlanner::windowDistance(uint32_t cell, const WindowSearch& s) const {
+    const int row = static_cast<int>(cell / width) - s.row0, col = static_cast<int>(cell % width) - s.col0;
+    if (row < 0 || row >= s.rows || col < 0 || col >= s.cols) return NO_PATH;
+    const int local = row * s.cols + col;
+    return s.stamp[local] == s.generation ? s.distance[local] : NO_PATH;
+}
+
+// --- Build ---
+void HierarchicalPlanner::build(const Maze& m, int size, int threads) {
+    width = m.width();
+    height = m.height();
+    // Local cell indices and distances in a 2 x 2 cluster window must fit in 16 bits
+    clusterSize = std::max(2, std::min(size, 128));
+    clustersX = (width + clusterSize - 1) / clusterSize;
+    clustersY = (height + clusterSize - 1) / clusterSize;
+    const int clusters = clustersX * clustersY;
+
+    // Transitions: pairs of open cells facing each other over a cluster border
+    std::vector<std::pair<uint32_t, uint32_t>> transitions;
+    auto open = [&](int row, int col) { return !m.isWall(row, col); };
+    auto addRun = [&](int start, int length, bool vertical, int line) {
+        // vertical: the run goes down column `line` | line + 1; otherwise along row `line` / line + 1
+        auto add = [&](int along) {
+            uint32_t a, b;
+            if (vertical) {
+                a = static_cast<uint32_t>(along) * width + line;
+                b = a + 1;
+            } else {
+                a = static_cast<uint32_t>(line) * width + along;
+                b = a + width;
+            }
+            transitions.emplace_back(a, b);
+        };
+        if (length >= WIDE_ENTRANCE) {
+            add(start);
+            for (int along = ENTRANCE_SPACING; along < length - 1; along += ENTRANCE_SPACING)
+                add(start + along);
+            add(start + length - 1);
+        } else {
+            add(start + length / 2);
+        }
+    };
+    for (int col = clusterSize - 1; col + 1 < width; col += clusterSize) {
+        for (int row0 = 0; row0 < height; row0 += clusterSize) {
+            const int row1 = std::min(row0 + clusterSize, height);
+            for (int row = row0; row < row1; ) {
+                if (!open(row, col) || !open(row, col + 1)) { ++row; continue; }
+                int start = row;
+                while (row < row1 && open(row, col) && open(row, col + 1)) ++row;
+                addRun(start, row - start, true, col);
+            }
+        }
+    }
+    for (int row = clusterSize - 1; row + 1 < height; row += clusterSize) {
+        for (int col0 = 0; col0 < width; col0 += clusterSize) {
+            const int col1 = std::min(col0 + clusterSize, width);
+            for (int col = col0; col < col1; ) {
+                if (!open(row, col) || !open(row + 1, col)) { ++col; continue; }
+                int start = col;
+                while (col < col1 && open(row, col) && open(row + 1, col)) ++col;
+                addRun(start, col - start, false, row);
+            }
+        }
+    }
+
+    // Nodes, grouped by cluster and sorted by cell; a corner cell can serve two borders
+    std::vector<std::pair<int, uint32_t>> placed;
+    placed.reserve(transitions.size() * 2);
+    for (const auto& t : transitions) {
+        placed.emplace_back(clusterOf(t.first), t.first);
+        placed.emplace_back(clusterOf(t.second), t.second);
+    }
+    std::sort(placed.begin(), placed.end());
+    placed.erase(std::unique(placed.begin(), placed.end()), placed.end());
+
+    clusterNodes.assign(clusters + 1, 0);
+    nodeCells.resize(placed.size());
+    for (std::size_t i = 0; i < placed.size(); ++i) {
+        ++clusterNodes[placed[i].first + 1];
+        nodeCells[i] = placed[i].second;
+    }
+    for (int c = 0; c < clusters; ++c)
+        clusterNodes[c + 1] += clusterNodes[c];
+
+    auto nodeOf = [&](uint32_t cell) {
+        const int cluster = clusterOf(cell);
+        auto first = nodeCells.begin() + clusterNodes[cluster], last = nodeCells.begin() + clusterNodes[cluster + 1];
+        return static_cast<int32_t>(std::lower_bound(first, last, cell) - nodeCells.begin());
+    };
+    across.assign(nodeCells.size(), std::make_pair(-1, -1));
+    auto link = [&](int32_t from, int32_t to) {
+        std::pair<int32_t, int32_t>& slots = across[from];
+        if (slots.first == to || slots.second == to) return;
+        (slots.first < 0 ? slots.first : slots.second) = to;
+    };
+    for (const auto& t : transitions) {
+        int32_t a = nodeOf(t.first), b = nodeOf(t.second);
+        link(a, b);
+        link(b, a);
+    }
+
+    // Intra-cluster distances, one bounded BFS per node; clusters are independent
+    matrixOffsets.assign(clusters + 1, 0);
+    for (int c = 0; c < clusters; ++c) {
+        const std::size_t count = clusterNodes[c + 1] - clusterNodes[c];
+        matrixOffsets[c + 1] = matrixOffsets[c] + count * count;
+    }
+    distances.assign(matrixOffsets.back(), NO_PATH);
+
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    std::atomic<int> nextCluster(0);
+    auto work = [&]() {
+        WindowSearch s;
+        for (int c = nextCluster++; c < clusters; c = nextCluster++) {
+            const uint32_t first = clusterNodes[c], count = clusterNodes[c + 1] - first;
+            uint16_t* matrix = distances.data() + matrixOffsets[c];
+            for (uint32_t i = 0; i < count; ++i) {
+                searchCluster(m, nodeCells[first + i], s);
+                for (uint32_t j = 0; j < count; ++j)
+                    matrix[i * count + j] = windowDistance(nodeCells[first + j], s);
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool)
+        t.join();
+
+    const std::size_t slots = nodeCells.size() + 2;
+    g.assign(slots, 0);
+    stamp.assign(slots, 0);
+    parentNode.assign(slots, -1);
+    generation = 0;
+    goals.clear();
+}
+
+// --- Queries ---
+bool HierarchicalPlanner::plan(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                               std::vector<uint32_t>& waypoints) {
+    waypoints.clear();
+    expanded = 0;
+    if (!m.inBounds(startRow, startCol) || m.isWall(startRow, startCol)) return false;
+    if (!m.inBounds(goalRow, goalCol) || m.isWall(goalRow, goalCol)) return false;
+
+    const uint32_t startCell = static_cast<uint32_t>(startRow) * width + startCol;
+    const uint32_t goalCell = static_cast<uint32_t>(goalRow) * width + goalCol;
+    if (startCell == goalCell) {
+        waypoints.push_back(startCell);
+        return true;
+    }
+
+    const int32_t START = static_cast<int32_t>(nodeCells.size()), GOAL = START + 1;
+    const int startCluster = clusterOf(startCell), goalCluster = clusterOf(goalCell);
+    const uint32_t startFirst = clusterNodes[startCluster], startCount = clusterNodes[startCluster + 1] - startFirst;
+    const uint32_t goalFirst = clusterNodes[goalCluster], goalCount = clusterNodes[goalCluster + 1] - goalFirst;
+
+    // Nearby ends: search the box around both clusters directly. Entrances
+    // sit at fixed points on each border, so a short route over one would
+    // otherwise detour through them.
+    uint16_t direct = NO_PATH;
+    if (clustersTouch(startCluster, goalCluster)) {
+        searchWindow(m, goalCell, startCluster, goalCluster, search);
+        direct = windowDistance(startCell, search);
+    }
+
+    // A cached goal only needs the start linked to its cluster's entrances
+    GoalRoutes* routes = nullptr;
+    for (GoalRoutes& r : goals)
+        if (r.goalCell == goalCell) routes = &r;
+    if (routes) {
+        routes->lastUsed = ++goalClock;
+        searchCluster(m, startCell, search);
+        uint32_t best = direct != NO_PATH ? direct : UNREACHED;
+        int32_t bestNode = -1;
+        for (uint32_t j = 0; j < startCount; ++j) {
+            const uint16_t cost = windowDistance(nodeCells[startFirst + j], search);
+            if (cost == NO_PATH || routes->cost[startFirst + j] == UNREACHED) continue;
+            if (cost + routes->cost[startFirst + j] < best) {
+                best = cost + routes->cost[startFirst + j];
+                bestNode = static_cast<int32_t>(startFirst + j);
+            }
+        }
+        if (best == UNREACHED) return false;
+        waypoints.push_back(startCell);
+        for (int32_t n = bestNode; n >= 0; n = routes->next[n])
+            waypoints.push_back(nodeCells[n]);
+        waypoints.push_back(goalCell);
+        waypoints.erase(std::unique(waypoints.begin(), waypoints.end()), waypoints.end());
+        smooth(waypoints);
+        return true;
+    }
+
+    // Connect the goal to the entrances of its cluster
+    searchCluster(m, goalCell, search);
+    goalLinks.resize(goalCount);
+    for (uint32_t j = 0; j < goalCount; ++j)
+        goalLinks[j] = windowDistance(nodeCells[goalFirst + j], search);
+
+    generation += 1;
+    const uint32_t openStamp = 2 * generation, closedStamp = openStamp + 1;
+    const int goalR = goalRow, goalC = goalCol;
+    auto heuristic = [&](uint32_t cell) {
+        return static_cast<uint32_t>(std::abs(static_cast<int>(cell / width) - goalR) +
+                                     std::abs(static_cast<int>(cell % width) - goalC));
+    };
+    auto later = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; };
+    auto relax = [&](int32_t from, int32_t to, uint32_t cost) {
+        if (stamp[to] == closedStamp) return;
+        const uint32_t total = g[from] + cost;
+        if (stamp[to] == openStamp && g[to] <= total) return;
+        stamp[to] = openStamp;
+        g[to] = total;
+        parentNode[to] = from;
+        const uint32_t cell = to == GOAL ? goalCell : nodeCells[to];
+        heap.push_back({ total + heuristic(cell), static_cast<uint32_t>(to) });
+        std::push_heap(heap.begin(), heap.end(), later);
+    };
+
+    heap.clear();
+    stamp[START] = openStamp;
+    g[START] = 0;
+    parentNode[START] = -1;
+    heap.push_back({ heuristic(startCell), static_cast<uint32_t>(START) });
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        const int32_t node = static_cast<int32_t>(heap.back().node);
+        heap.pop_back();
+        if (stamp[node] == closedStamp) continue;
+        stamp[node] = closedStamp;
+        ++expanded;
+
+        if (node == GOAL) {
+            for (int32_t n = GOAL; n >= 0; n = parentNode[n])
+                waypoints.push_back(n == GOAL ? goalCell : n == START ? startCell : nodeCells[n]);
+            std::reverse(waypoints.begin(), waypoints.end());
+            // An entrance on the start or goal cell appears twice
+            waypoints.erase(std::unique(waypoints.begin(), waypoints.end()), waypoints.end());
+            smooth(waypoints);
+            return true;
+        }
+
+        if (node == START) {
+            if (direct != NO_PATH) relax(START, GOAL, direct);
+            searchCluster(m, startCell, search);
+            for (uint32_t j = 0; j < startCount; ++j) {
+                uint16_t cost = windowDistance(nodeCells[startFirst + j], search);
+                if (cost != NO_PATH) relax(START, static_cast<int32_t>(startFirst + j), cost);
+            }
+            continue;
+        }
+
+        const int cluster = clusterOf(nodeCells[node]);
+        const uint32_t first = clusterNodes[cluster], count = clusterNodes[cluster + 1] - first;
+        const uint16_t* row = distances.data() + matrixOffsets[cluster] + (node - first) * count;
+        for (uint32_t j = 0; j < count; ++j)
+            if (row[j] != NO_PATH && row[j] != 0) relax(node, static_cast<int32_t>(first + j), row[j]);
+        if (across[node].first >= 0) relax(node, across[node].first, 1);
+        if (across[node].second >= 0) relax(node, across[node].second, 1);
+        if (cluster == goalCluster && goalLinks[node - first] != NO_PATH)
+            relax(node, GOAL, goalLinks[node - first]);
+    }
+    return false;
+}
+
+// Dijkstra outwards from the goal; the graph is undirected, so the cost
+// from the goal to a node is also the cost from the node to the goal
+void HierarchicalPlanner::cacheGoal(const Maze& m, int goalRow, int goalCol) {
+    expanded = 0;
+    if (!m.inBounds(goalRow, goalCol) || m.isWall(goalRow, goalCol)) return;
+    const uint32_t goalCell = static_cast<uint32_t>(goalRow) * width + goalCol;
+
+    GoalRoutes* routes = nullptr;
+    for (GoalRoutes& r : goals)
+        if (r.goalCell == goalCell) routes = &r;
+    if (routes) {
+        routes->lastUsed = ++goalClock;
+        return;
+    }
+    if (goals.size() < static_cast<std::size_t>(MAX_CACHED_GOALS)) {
+        goals.emplace_back();
+        routes = &goals.back();
+    } else {
+        routes = &*std::min_element(goals.begin(), goals.end(), [](const GoalRoutes& a, const GoalRoutes& b) {
+            return a.lastUsed < b.lastUsed;
+        });
+    }
+    routes->goalCell = goalCell;
+    routes->lastUsed = ++goalClock;
+    routes->cost.assign(nodeCells.size(), UNREACHED);
+    routes->next.assign(nodeCells.size(), -1);
+
+    auto later = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; };
+    auto relax = [&](int32_t from, int32_t to, uint32_t cost) {
+        if (routes->cost[to] <= cost) return;
+        routes->cost[to] = cost;
+        routes->next[to] = from;
+        heap.push_back({ cost, static_cast<uint32_t>(to) });
+        std::push_heap(heap.begin(), heap.end(), later);
+    };
+
+    heap.clear();
+    const int goalCluster = clusterOf(goalCell);
+    const uint32_t goalFirst = clusterNodes[goalCluster], goalCount = clusterNodes[goalCluster + 1] - goalFirst;
+    searchCluster(m, goalCell, search);
+    for (uint32_t j = 0; j < goalCount; ++j) {
+        const uint16_t cost = windowDistance(nodeCells[goalFirst + j], search);
+        if (cost != NO_PATH) relax(-1, static_cast<int32_t>(goalFirst + j), cost);
+    }
+
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), later);
+        const OpenEntry entry = heap.back();
+        heap.pop_back();
+        const int32_t node = static_cast<int32_t>(entry.node);
+        if (entry.f != routes->cost[node]) continue; // superseded
+        ++expanded;
+
+        const int cluster = clusterOf(nodeCells[node]);
+        const uint32_t first = clusterNodes[cluster], count = clusterNodes[cluster + 1] - first;
+        const uint16_t* row = distances.data() + matrixOffsets[cluster] + (node - first) * count;
+        for (uint32_t j = 0; j < count; ++j)
+            if (row[j] != NO_PATH && row[j] != 0) relax(node, static_cast<int32_t>(first + j), entry.f + row[j]);
+        if (across[node].first >= 0) relax(node, across[node].first, entry.f + 1);
+        if (across[node].second >= 0) relax(node, across[node].second, entry.f + 1);
+    }
+}
+
+// Every leg runs inside one cluster or steps over a border, so while all
+// the waypoints between two ends lie in the box of two touching clusters,
+// one search of that box finds a route at least as short. Greedily keep
+// only the waypoints where the next one would leave the box.
+void HierarchicalPlanner::smooth(std::vector<uint32_t>& waypoints) const {
+    auto fits = [&](std::size_t from, std::size_t to) {
+        const int a = clusterOf(waypoints[from]), b = clusterOf(waypoints[to]);
+        if (!clustersTouch(a, b)) return false;
+        const int rowLo = std::min(a / clustersX, b / clustersX), rowHi = std::max(a / clustersX, b / clustersX);
+        const int colLo = std::min(a % clustersX, b % clustersX), colHi = std::max(a % clustersX, b % clustersX);
+        for (std::size_t k = from + 1; k < to; ++k) {
+            const int c = clusterOf(waypoints[k]);
+            if (c / clustersX < rowLo || c / clustersX > rowHi || c % clustersX < colLo || c % clustersX > colHi)
+                return false;
+        }
+        return true;
+    };
+
+    std::size_t kept = 1, anchor = 0;
+    for (std::size_t k = 1; k < waypoints.size(); ++k) {
+        if (k + 1 < waypoints.size() && fits(anchor, k + 1)) continue;
+        waypoints[kept++] = waypoints[k];
+        anchor = k;
+    }
+    waypoints.resize(kept);
+}
+
+bool HierarchicalPlanner::refine(const Maze& m, uint32_t from, uint32_t to, std::vector<uint32_t>& cells) {
+    const int steps = std::abs(static_cast<int>(from / width) - static_cast<int>(to / width)) +
+                      std::abs(static_cast<int>(from % width) - static_cast<int>(to % width));
+    if (steps <= 1) {
+        // Same cell, or a step between neighbours (possibly over a border)
+        cells.push_back(from);
+        if (steps == 1) cells.push_back(to);
+        return true;
+    }
+    const int fromCluster = clusterOf(from), toCluster = clusterOf(to);
+    if (!clustersTouch(fromCluster, toCluster)) return false;
+
+    // Search from the far end so the parents lead forwards
+    searchWindow(m, to, fromCluster, toCluster, search);
+    if (windowDistance(from, search) == NO_PATH) return false;
+    uint32_t cell = from;
+    cells.push_back(cell);
+    while (cell != to) {
+        const int local = (static_cast<int>(cell / width) - search.row0) * search.cols +
+                          static_cast<int>(cell % width) - search.col0;
+        const int dir = search.parent[local];
+        cell = static_cast<uint32_t>(static_cast<int64_t>(cell) - DC[dir] - static_cast<int64_t>(DR[dir]) * width);
+        cells.push_back(cell);
+    }
+    return true;
+}
+
+bool HierarchicalPlanner::refineAll(const Maze& m, const std::vector<uint32_t>& waypoints,
+                                    std::vector<uint32_t>& cells) {
+    cells.clear();
+    if (waypoints.size() == 1) cells.push_back(waypoints[0]);
+    for (std::size_t i = 0; i + 1 < waypoints.size(); ++i) {
+        // Each leg starts where the previous one ended
+        if (i > 0) cells.pop_back();
+        if (!refine(m, waypoints[i], waypoints[i + 1], cells)) return false;
+    }
+    return true;
+}
+
+std::size_t HierarchicalPlanner::memoryBytes() const {
+    std::size_t goalBytes = 0;
+    for (const GoalRoutes& r : goals)
+        goalBytes += r.cost.capacity() * sizeof(uint32_t) + r.next.capacity() * sizeof(int32_t);
+    return clusterNodes.capacity() * sizeof(uint32_t) + nodeCells.capacity() * sizeof(uint32_t) +
+           across.capacity() * sizeof(across[0]) + matrixOffsets.capacity() * sizeof(std::size_t) +
+           distances.capacity() * sizeof(uint16_t) +
+           (g.capacity() + stamp.capacity() + parentNode.capacity()) * sizeof(uint32_t) +
+           heap.capacity() * sizeof(OpenEntry) + goalBytes;
+}
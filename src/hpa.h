@@ -0,0 +1,116 @@
+#ifndef HPA_H
+#define HPA_H
+
+#include "chunk.h"
+#include "maze_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Two-level path planner (HPA*). The grid is cut into square clusters, by
+// default the size of a render chunk. Where open cells face each other
+// across a cluster border, entrance nodes are placed on both sides, and the
+// distances between the entrances of each cluster are precomputed.
+//
+// plan() searches this abstract graph, so a query only touches entrance
+// nodes. It returns waypoints, and refine() expands one leg into cells when
+// an agent is about to walk it. Ends in the same or touching clusters also
+// get a direct search, and legs are merged so each one spans two clusters
+// and picks its own border crossing. Perfect mazes have one route, which is
+// always found. With rooms carved in, about 1 route in 1000 over 30 cells
+// comes out more than 5% longer than the shortest, at worst 12% longer.
+//
+// Many agents heading for one goal should call cacheGoal() first: it runs
+// one search from the goal over the whole abstract graph (about 130 ms on a
+// 4k x 4k grid), after which plan() only searches the start's cluster and
+// reads the route off in well under a millisecond.
+//
+// Queries reuse scratch held by the planner, so each thread needs its own.
+class HierarchicalPlanner {
+public:
+    // Rebuild after the maze changes. threads = 0 uses every hardware thread.
+    void build(const Maze& m, int clusterSize = CHUNK_SIZE, int threads = 0);
+
+    // Waypoints are linear cell indices (row * width + col) from start to
+    // goal; consecutive waypoints are neighbours or lie in clusters that
+    // touch, sides or corners. Returns false, leaving waypoints empty, if
+    // either end is blocked or unreachable.
+    bool plan(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+              std::vector<uint32_t>& waypoints);
+    // Keep the abstract routes from every entrance to this goal, for the
+    // last MAX_CACHED_GOALS goals; plan() uses them instead of searching.
+    // Ignored if the goal is blocked.
+    void cacheGoal(const Maze& m, int goalRow, int goalCol);
+    // Append the cells from waypoint `from` to waypoint `to`, both included
+    bool refine(const Maze& m, uint32_t from, uint32_t to, std::vector<uint32_t>& cells);
+    // Refine every leg; the result is a full cell path like MazeSolver's
+    bool refineAll(const Maze& m, const std::vector<uint32_t>& waypoints, std::vector<uint32_t>& cells);
+
+    std::size_t nodeCount() const { return nodeCells.size(); }
+    // Abstract nodes taken off the open set by the last plan(), or by the
+    // last cacheGoal(); plan() expands none for a cached goal
+    std::size_t nodesExpanded() const { return expanded; }
+    std::size_t memoryBytes() const;
+
+    static const int MAX_CACHED_GOALS = 4;
+
+private:
+    // Cells reachable from one cell without leaving a window of at most
+    // 2 x 2 clusters, so local indices fit in 16 bits
+    struct WindowSearch {
+        int row0 = 0, col0 = 0, rows = 0, cols = 0;
+        std::vector<uint16_t> distance; // valid where stamp == generation
+        std::vector<uint32_t> stamp;
+        std::vector<uint8_t> parent;    // direction taken into each cell
+        std::vector<uint16_t> queue;
+        uint32_t generation = 0;
+    };
+    // Cost and next node towards one goal, for every node
+    struct GoalRoutes {
+        uint32_t goalCell = 0;
+        uint64_t lastUsed = 0;
+        std::vector<uint32_t> cost; // UNREACHED if the goal cannot be reached
+        std::vector<int32_t> next;  // -1: walk straight to the goal
+    };
+
+    int clusterOf(uint32_t cell) const;
+    void clusterBounds(int cluster, int& row0, int& col0, int& rows, int& cols) const;
+    // Same cluster, or neighbours across a side or a corner
+    bool clustersTouch(int a, int b) const;
+    // Breadth-first from cell, bounded by the box around clusters a and b
+    void searchWindow(const Maze& m, uint32_t cell, int a, int b, WindowSearch& s) const;
+    void searchCluster(const Maze& m, uint32_t cell, WindowSearch& s) const {
+        searchWindow(m, cell, clusterOf(cell), clusterOf(cell), s);
+    }
+    uint16_t windowDistance(uint32_t cell, const WindowSearch& s) const;
+    // Merge legs while the route between the ends stays in two touching clusters
+    void smooth(std::vector<uint32_t>& waypoints) const;
+
+    int width = 0, height = 0;
+    int clusterSize = 0, clustersX = 0, clustersY = 0;
+
+    // Nodes are grouped by cluster and sorted by cell within each cluster
+    std::vector<uint32_t> clusterNodes;    // first node of each cluster, plus an end entry
+    std::vector<uint32_t> nodeCells;
+    std::vector<std::pair<int32_t, int32_t>> across; // neighbours over a border, -1 if none
+    std::vector<std::size_t> matrixOffsets; // per cluster, into distances
+    std::vector<uint16_t> distances;        // count x count per cluster, NO_PATH if disconnected
+
+    // Query scratch, indexed by node; start and goal are the two extra slots
+    struct OpenEntry {
+        uint32_t f, node;
+    };
+    std::vector<uint32_t> g, stamp; // stamp is 2 * generation while open, + 1 once closed
+    std::vector<int32_t> parentNode;
+    std::vector<uint16_t> goalLinks; // cost from each node of the goal cluster to the goal
+    std::vector<OpenEntry> heap;
+    uint32_t generation = 0;
+    std::size_t expanded = 0;
+    WindowSearch search;
+
+    std::vector<GoalRoutes> goals;
+    uint64_t goalClock = 0;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "input_log.h"
+#include <fstream>
+#include <iostream>
+
+static const uint32_t INPUT_LOG_MAGIC = 0x4E494D4Du; // "MMIN"
+static const uint32_t INPUT_LOG_VERSION = 1;
+
+void InputLog::clear() {
+    seconds.clear();
+    keys.clear();
+}
+
+void InputLog::add(float frameSeconds, uint8_t frameKeys) {
+    seconds.push_back(frameSeconds);
+    keys.push_back(frameKeys);
+}
+
+// --- Persistence ---
+// Header (magic, version, maze width, maze height, frame count), then every
+// frame time, then every key byte: 5 bytes per frame
+bool InputLog::save(const std::string& path, int mazeWidth, int mazeHeight) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write input log " << path << "\n";
+        return false;
+    }
+    uint32_t header[5] = { INPUT_LOG_MAGIC, INPUT_LOG_VERSION, static_cast<uint32_t>(mazeWidth),
+                           static_cast<uint32_t>(mazeHeight), static_cast<uint32_t>(size()) };
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(seconds.data()), seconds.size() * sizeof(float));
+    file.write(reinterpret_cast<const char*>(keys.data()), keys.size());
+    return static_cast<bool>(file);
+}
+
+bool InputLog::load(const std::string& path, int mazeWidth, int mazeHeight) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to read input log " << path << "\n";
+        return false;
+    }
+
+    uint32_t header[5] = {};
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!file || header[0] != INPUT_LOG_MAGIC || header[1] != INPUT_LOG_VERSION) {
+        std::cerr << "Input log " << path << " is not valid\n";
+        return false;
+    }
+    if (static_cast<int>(header[2]) != mazeWidth || static_cast<int>(header[3]) != mazeHeight) {
+        std::cerr << "Input log " << path << " was recorded on a different maze\n";
+        return false;
+    }
+
+    seconds.resize(header[4]);
+    keys.resize(header[4]);
+    file.read(reinterpret_cast<char*>(seconds.data()), seconds.size() * sizeof(float));
+    file.read(reinterpret_cast<char*>(keys.data()), keys.size());
+    if (!file) {
+        std::cerr << "Input log " << path << " is truncated\n";
+        clear();
+        return false;
+    }
+    return true;
+}
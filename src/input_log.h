@@ -0,0 +1,39 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Movement keys held during a frame, one bit each
+enum InputKey : uint8_t {
+    KEY_FORWARD = 1 << 0,
+    KEY_BACK = 1 << 1,
+    KEY_LEFT = 1 << 2,
+    KEY_RIGHT = 1 << 3,
+};
+
+// Keyboard input recorded frame by frame, with each frame's elapsed time.
+// Frame times are kept as the exact floats the game loop used, so feeding
+// them back through the fixed timestep reproduces the same simulation steps
+// and the same walk through the maze, however fast the replay runs.
+class InputLog {
+public:
+    void clear();
+    void add(float frameSeconds, uint8_t keys);
+
+    // The maze size is stored so a replay on a different level is caught
+    bool save(const std::string& path, int mazeWidth, int mazeHeight) const;
+    bool load(const std::string& path, int mazeWidth, int mazeHeight);
+
+    std::size_t size() const { return keys.size(); }
+    float frameSeconds(std::size_t frame) const { return seconds[frame]; }
+    uint8_t frameKeys(std::size_t frame) const { return keys[frame]; }
+
+private:
+    std::vector<float> seconds;
+    std::vector<uint8_t> keys;
+};
+
+#endif
@@ -4,12 +4,28 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <memory>
+#include "collision.h"
+#include "crowd_render.h"
+#include "fixed_step.h"
+#include "frame_stats.h"
+#include "generator.h"
+#include "gl_stats.h"
+#include "gpu_timer.h"
+#include "headless.h"
+#include "input_log.h"
 #include "maze.h"
+#include "profiler.h"
+#include "pvs.h"
+#include "shader.h"
+#include "software_raster.h"
+#include "visibility.h"
 
-#define MAZE_SIZE 20
 const float spacing = 4.0f;
 
 // Camera variables
@@ -19,6 +35,9 @@ float camY = 4.0f;
 float yaw = -90.0f, pitch = 0.0f;
 float frontX = 0.0f, frontY = 0.0f, frontZ = -1.0f;
 
+// Collision radius of the camera body, keeps the near plane out of the walls
+const float CAMERA_RADIUS = 1.0f;
+
 // Adjusted speeds for full-screen feel
 float speedForward = 8.0f;  // units per second
 float speedTurn = 180.0f;   // degrees per second
@@ -27,12 +46,89 @@ float speedTurn = 180.0f;   // degrees per second
 float deltaTime = 0.0f;  // Time between current frame and last frame
 float lastFrame = 0.0f;
 
+// The simulation runs at a fixed rate whatever the frame rate; frames draw
+// the camera blended between its last two simulated states
+FixedTimestep timestep(120.0);
+struct CameraState {
+    float x, z, yaw;
+};
+CameraState previousCamera = { camX, camZ, yaw };
+
+// Keys held this frame, sampled once and applied to every step
+struct InputState {
+    bool forward = false, back = false, left = false, right = false;
+};
+InputState input;
+
+// --record <file> saves every frame's input and time when the game exits;
+// --replay <file> plays them back instead of the keyboard, without vsync,
+// and reports the frame times
+InputLog inputLog;
+const char* recordPath = nullptr;
+bool replaying = false;
+
+// Endless corridor mode: a fixed window of rows streamed from Eller's
+// algorithm. Once the camera is deep enough into the window, the oldest
+// rows are dropped, new ones are appended and the camera is shifted back
+// by the same distance, so memory and coordinates both stay bounded.
+const int CORRIDOR_WINDOW_ROWS = 96;
+const int CORRIDOR_SCROLL_ROWS = 32; // even, keeps room/wall rows aligned
+std::unique_ptr<EllerGenerator> corridor;
+
+const float VIEW_DISTANCE = 300.0f; // far plane
+const glm::vec3 CLEAR_COLOR(0.05f, 0.05f, 0.1f);
+
+// Cells in sight this frame: the precomputed PVS of the camera's cell when
+// one is loaded, otherwise a per-frame grid ray pass
+GridVisibility visibility;
+PotentiallyVisibleSet pvs;
+PvsLookup pvsLookup;
+const CellVisibility* inSight = &visibility; // whichever drew the last frame
+
+// NPCs walking to the exit, when --crowd asks for them
+std::unique_ptr<Crowd> crowd;
+CrowdRenderer crowdRenderer;
+
+// --headless <frames>: draw that many frames offscreen, print the frame
+// times and exit, for benchmark runs without a display. With --replay,
+// 0 frames plays the whole log.
+bool headless = false;
+int headlessFrames = 0;
+const int HEADLESS_WIDTH = 800, HEADLESS_HEIGHT = 600;
+
+// --profile <file>: time each part of the frame on the CPU and, through
+// timer queries, on the GPU; the Chrome trace is written at exit or on F12
+const char* profilePath = nullptr;
+GpuTimer gpuTimer;
+
+// --thumbnail <file.ppm>: draw the starting view with the CPU rasterizer
+// and exit, without any GL context
+const char* thumbnailPath = nullptr;
+
 // Function declarations
-GLuint loadShader(const char* vertexPath, const char* fragmentPath);
+bool loadLevel(int argc, char** argv);
+bool findExit(const Maze& m, int& row, int& col);
+void advanceCorridor();
+int runHeadless();
+int renderThumbnail();
+FrameUniforms frameUniformsFor(const CameraState& eye, int width, int height);
+void renderFrame(ShaderProgram& shader, FrameUniformBuffer& frameUniforms, int width, int height);
+void reportCullStats(GLFWwindow* window, float now);
 void processInput(GLFWwindow* window);
+bool replayFrame(std::size_t frame, float& frameSeconds);
+void recordFrame(float frameSeconds);
+void simulate(float dt);
+CameraState interpolateCamera(float alpha);
 void framebuffer_size_callback(GLFWwindow* window, int width, int height);
 
-int main() {
+int main(int argc, char** argv) {
+    if (!loadLevel(argc, argv))
+        return -1;
+    if (thumbnailPath)
+        return renderThumbnail();
+    if (headless)
+        return runHeadless();
+
     if (!glfwInit()) {
         std::cerr << "Failed to initialize GLFW\n";
         return -1;
@@ -61,127 +157,528 @@ int main() {
     // Callback for window resize
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
 
-    GLuint shaderProgram = loadShader("shader.vert", "shader.frag");
+    ShaderProgram shader;
+    if (!shader.load("shader.vert", "shader.frag")) {
+        glfwTerminate();
+        return -1;
+    }
+    shader.bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+
+    FrameUniformBuffer frameUniforms;
+    frameUniforms.create(FRAME_UNIFORM_BINDING);
+
     initMaze();
+    if (crowd)
+        crowdRenderer.create();
+    if (profilePath)
+        gpuTimer.create();
+
+    using Clock = std::chrono::steady_clock;
+    FrameStats replayStats;
+    std::size_t frameIndex = 0;
+    if (replaying)
+        glfwSwapInterval(0);
 
     while (!glfwWindowShouldClose(window)) {
+        PROFILE_SCOPE("frame");
+        Clock::time_point frameStart = Clock::now();
+        gpuTimer.beginFrame();
+
         // Calculate deltaTime
         float currentFrame = glfwGetTime();
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
 
-        // Process keyboard input
-        processInput(window);
-
-        // Clear buffers
-        glClearColor(0.05f, 0.05f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        // Process keyboard input, then catch the simulation up to now
+        {
+            PROFILE_SCOPE("input");
+            processInput(window);
+            if (replaying && !replayFrame(frameIndex++, deltaTime))
+                break;
+            recordFrame(deltaTime);
+        }
+        for (int steps = timestep.advance(deltaTime); steps > 0; --steps)
+            simulate(timestep.step());
 
-        // Camera and projection matrices
         int width, height;
         glfwGetFramebufferSize(window, &width, &height);
+        renderFrame(shader, frameUniforms, width, height);
+        reportCullStats(window, currentFrame);
+
+        {
+            PROFILE_SCOPE("swap");
+            glfwSwapBuffers(window);
+            glfwPollEvents(); // process events and callbacks
+        }
+        GlCallStats::endFrame();
+        if (replaying) {
+            glFinish();
+            replayStats.add(std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count());
+        }
+    }
+    if (replaying)
+        replayStats.print("Replay");
+    if (recordPath)
+        inputLog.save(recordPath, maze.width(), maze.height());
+    if (profilePath)
+        Profiler::writeChromeTrace(profilePath);
+
+    gpuTimer.destroy();
+    crowdRenderer.destroy();
+    crowd.reset();
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    return 0;
+}
 
-        glm::mat4 view = glm::lookAt(glm::vec3(camX, camY, camZ),
-                                     glm::vec3(camX + frontX, camY, camZ + frontZ),
-                                     glm::vec3(0.0f, 1.0f, 0.0f));
+// --- Drawing one frame, blended between the last two simulation steps ---
+void renderFrame(ShaderProgram& shader, FrameUniformBuffer& frameUniforms, int width, int height) {
+    CameraState eye = interpolateCamera(timestep.alpha());
+    float eyeFrontX = cos(glm::radians(pitch)) * cos(glm::radians(eye.yaw));
+    float eyeFrontZ = cos(glm::radians(pitch)) * sin(glm::radians(eye.yaw));
+    {
+        PROFILE_SCOPE("chunk streaming");
+        updateMaze(eye.x, eye.z);
+    }
 
-        glm::mat4 projection = glm::perspective(glm::radians(65.0f),
-                                                (float)width / (float)height,
-                                                0.1f, 300.0f);
+    // Clear buffers
+    glClearColor(CLEAR_COLOR.r, CLEAR_COLOR.g, CLEAR_COLOR.b, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        glm::vec3 lightPos(camX, camY, camZ);
-        glm::vec3 lightDir(frontX, frontY, frontZ); // NEW
+    FrameUniforms frame = frameUniformsFor(eye, width, height);
+    const glm::mat4& view = frame.view;
+    const glm::mat4& projection = frame.projection;
 
-        glUseProgram(shaderProgram);
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-        glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-        glUniform3fv(glGetUniformLocation(shaderProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-        glUniform3fv(glGetUniformLocation(shaderProgram, "viewPos"), 1, glm::value_ptr(glm::vec3(camX, camY, camZ)));
+    {
+        PROFILE_SCOPE("uniform upload");
+        shader.use();
+        frameUniforms.upload(frame);
+    }
 
-        glUniform3fv(glGetUniformLocation(shaderProgram, "lightDir"), 1, glm::value_ptr(lightDir)); // NEW
+    inSight = &visibility;
+    {
+        PROFILE_SCOPE("culling");
+        int camRow = static_cast<int>(-eye.z / spacing), camCol = static_cast<int>(eye.x / spacing);
+        if (!pvs.empty() && pvsLookup.select(pvs, maze, camRow, camCol)) {
+            inSight = &pvsLookup;
+        } else {
+            // Grid rays across the horizontal FOV find the cells actually in sight
+            float horizontalFov = 2.0f * atan(tan(glm::radians(65.0f) / 2.0f) * (float)width / (float)height);
+            visibility.compute(maze, spacing, eye.x, eye.z, eyeFrontX, eyeFrontZ, horizontalFov + glm::radians(4.0f), VIEW_DISTANCE);
+        }
+    }
+    {
+        PROFILE_SCOPE("drawMaze");
+        gpuTimer.begin("drawMaze");
+        drawMaze(shader, projection * view, *inSight);
+        gpuTimer.end();
+    }
+    if (crowd) {
+        PROFILE_SCOPE("crowd draw");
+        gpuTimer.begin("crowd draw");
+        crowdRenderer.draw(shader, *crowd, spacing);
+        gpuTimer.end();
+    }
+}
 
-        // Spotlight cutoff angles (in radians)
-        float innerAngle = glm::cos(glm::radians(8.5f)); // NEW
-        float outerAngle = glm::cos(glm::radians(15.0f)); 
-        glUniform1f(glGetUniformLocation(shaderProgram, "cutOff"), innerAngle); // NEW
-        glUniform1f(glGetUniformLocation(shaderProgram, "outerCutOff"), outerAngle); // NEW
+// Camera, projection and spotlight for a frame seen from eye
+FrameUniforms frameUniformsFor(const CameraState& eye, int width, int height) {
+    float eyeFrontX = cos(glm::radians(pitch)) * cos(glm::radians(eye.yaw));
+    float eyeFrontZ = cos(glm::radians(pitch)) * sin(glm::radians(eye.yaw));
+
+    // Camera and projection matrices
+    FrameUniforms frame = {};
+    frame.view = glm::lookAt(glm::vec3(eye.x, camY, eye.z),
+                             glm::vec3(eye.x + eyeFrontX, camY, eye.z + eyeFrontZ),
+                             glm::vec3(0.0f, 1.0f, 0.0f));
+    frame.projection = glm::perspective(glm::radians(65.0f),
+                                        (float)width / (float)height,
+                                        0.1f, VIEW_DISTANCE);
+    frame.lightPos = glm::vec3(eye.x, camY, eye.z);
+    frame.viewPos = glm::vec3(eye.x, camY, eye.z);
+    frame.lightDir = glm::vec3(eyeFrontX, frontY, eyeFrontZ);
+
+    // Spotlight cutoff angles (cosines)
+    frame.cutOff = glm::cos(glm::radians(8.5f));
+    frame.outerCutOff = glm::cos(glm::radians(15.0f));
+
+    frame.lightColor = glm::vec3(1.0f, 1.0f, 1.0f);
+    frame.objectColor = glm::vec3(0.2f, 0.6f, 1.0f);
+    return frame;
+}
 
-        glUniform3f(glGetUniformLocation(shaderProgram, "lightColor"), 1.0f, 1.0f, 1.0f);
-        glUniform3f(glGetUniformLocation(shaderProgram, "objectColor"), 0.2f, 0.6f, 1.0f);
+// --- Software thumbnail ---
+// The starting view through SoftwareRasterizer; walls and floor only, the
+// crowd is not drawn
+int renderThumbnail() {
+    const FrameUniforms uniforms = frameUniformsFor(interpolateCamera(1.0f), HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    RasterFrame frame;
+    frame.view = uniforms.view;
+    frame.projection = uniforms.projection;
+    frame.lightPos = uniforms.lightPos;
+    frame.viewPos = uniforms.viewPos;
+    frame.lightDir = uniforms.lightDir;
+    frame.lightColor = uniforms.lightColor;
+    frame.objectColor = uniforms.objectColor;
+    frame.cutOff = uniforms.cutOff;
+    frame.outerCutOff = uniforms.outerCutOff;
+    frame.clearColor = CLEAR_COLOR;
+
+    using Clock = std::chrono::steady_clock;
+    SoftwareRasterizer raster;
+    raster.setScene(maze, spacing);
+    raster.resize(HEADLESS_WIDTH, HEADLESS_HEIGHT);
+    Clock::time_point start = Clock::now();
+    raster.render(frame);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout << "Software render: " << raster.trianglesDrawn() << " triangles in " << ms << " ms\n";
+    return raster.savePpm(thumbnailPath) ? 0 : -1;
+}
 
-        drawMaze(shaderProgram);
+// --- Headless benchmark ---
+// Same scene and simulation as the window, drawn into an offscreen
+// framebuffer. Every frame advances a fixed 1/60 s with the camera turning
+// right, or follows the --replay log, so runs are repeatable. glFinish()
+// stands in for the buffer swap so each sample covers the frame's GPU work.
+int runHeadless() {
+    HeadlessContext context;
+    if (!context.createContext())
+        return -1;
 
-        glfwSwapBuffers(window);
-        glfwPollEvents(); // process events and callbacks
+    // GLEW's glewInit() asks GLX for extensions, which has no display here
+    glewExperimental = GL_TRUE;
+    if (glewContextInit() != GLEW_OK) {
+        std::cerr << "Failed to initialize GLEW\n";
+        return -1;
     }
+    std::cout << "Headless: " << glGetString(GL_RENDERER) << ", "
+              << HEADLESS_WIDTH << "x" << HEADLESS_HEIGHT << "\n";
+    if (!context.createFramebuffer(HEADLESS_WIDTH, HEADLESS_HEIGHT))
+        return -1;
 
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    glEnable(GL_DEPTH_TEST);
+
+    ShaderProgram shader;
+    if (!shader.load("shader.vert", "shader.frag"))
+        return -1;
+    shader.bindUniformBlock("Frame", FRAME_UNIFORM_BINDING);
+
+    FrameUniformBuffer frameUniforms;
+    frameUniforms.create(FRAME_UNIFORM_BINDING);
+
+    initMaze();
+    if (crowd)
+        crowdRenderer.create();
+    if (profilePath)
+        gpuTimer.create();
+
+    using Clock = std::chrono::steady_clock;
+    FrameStats stats;
+    int frames = headlessFrames;
+    if (replaying && (frames <= 0 || frames > static_cast<int>(inputLog.size())))
+        frames = static_cast<int>(inputLog.size());
+    input.right = true;
+    for (int frame = 0; frame < frames; ++frame) {
+        PROFILE_SCOPE("frame");
+        Clock::time_point start = Clock::now();
+        gpuTimer.beginFrame();
+        float frameSeconds = 1.0f / 60.0f;
+        if (replaying)
+            replayFrame(frame, frameSeconds);
+        recordFrame(frameSeconds);
+        for (int steps = timestep.advance(frameSeconds); steps > 0; --steps)
+            simulate(timestep.step());
+        renderFrame(shader, frameUniforms, HEADLESS_WIDTH, HEADLESS_HEIGHT);
+        {
+            PROFILE_SCOPE("finish");
+            glFinish();
+        }
+        GlCallStats::endFrame();
+        stats.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    stats.print(replaying ? "Headless replay" : "Headless");
+    if (recordPath)
+        inputLog.save(recordPath, maze.width(), maze.height());
+    if (profilePath)
+        Profiler::writeChromeTrace(profilePath);
+
+    const CullStats& cull = mazeCullStats();
+    std::cout << "Last frame: chunks " << cull.chunksDrawn << "/" << cull.chunksTested
+              << " drawn, " << inSight->visibleWallCells() << " walls in sight\n";
+    if (GlCallStats::ENABLED) {
+        char calls[256];
+        GlCallStats::format(GlCallStats::lastFrame(), calls, sizeof(calls));
+        std::cout << "Last frame GL calls: " << calls << "\n";
+    }
+
+    gpuTimer.destroy();
+    crowdRenderer.destroy();
+    crowd.reset();
     return 0;
 }
 
-// --- Smooth keyboard input using deltaTime ---
-void processInput(GLFWwindow* window) {
-    float moveSpeed = speedForward * deltaTime;
-    float turnSpeed = speedTurn * deltaTime;
+// --- Command line level selection ---
+// --maze <file>         load a text maze ('#' = wall)
+// --generate <algo>     backtracker | kruskal | wilson | prim
+// --size <rooms>        rooms per side for --generate (default 20)
+// --seed <n>            generator seed (default 1)
+// --endless             endless corridor streamed as the camera walks in -Z
+// --pvs <file>          load the level's PVS, or build and save it if missing/stale
+// --crowd <n>           n NPCs walking to the exit
+// --headless <frames>   render offscreen without a window and report frame times
+// --record <file>       save the keyboard input of this run
+// --replay <file>       play back a recorded run as fast as possible and report frame times
+// --profile <file>      record a frame profile and write it as a Chrome trace (also on F12)
+// --thumbnail <file>    render the starting view on the CPU to a .ppm image and exit
+// Without any of these the built-in layout is used.
+bool loadLevel(int argc, char** argv) {
+    const char* mazePath = nullptr;
+    const char* algoName = nullptr;
+    int rooms = 20;
+    unsigned long long seed = 1;
+    bool endless = false;
+    const char* pvsPath = nullptr;
+    int crowdSize = 0;
+    const char* replayPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--maze") && hasValue) mazePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--generate") && hasValue) algoName = argv[++i];
+        else if (!std::strcmp(argv[i], "--size") && hasValue) rooms = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--endless")) endless = true;
+        else if (!std::strcmp(argv[i], "--pvs") && hasValue) pvsPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--crowd") && hasValue) crowdSize = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--headless") && hasValue) {
+            headless = true;
+            headlessFrames = std::atoi(argv[++i]);
+        } else if (!std::strcmp(argv[i], "--record") && hasValue) recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay") && hasValue) replayPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--profile") && hasValue) profilePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--thumbnail") && hasValue) thumbnailPath = argv[++i];
+        else {
+            std::cerr << "Unknown or incomplete option " << argv[i] << "\n";
+            return false;
+        }
+    }
 
-    float deltaX = 0.0f, deltaZ = 0.0f;
+    if (mazePath) {
+        if (!maze.loadFromFile(mazePath))
+            return false;
+    } else if (endless) {
+        if (rooms <= 0) {
+            std::cerr << "Usage: --endless --size <rooms> --seed <n>\n";
+            return false;
+        }
+        corridor.reset(new EllerGenerator(rooms, seed));
+        maze.resize(corridor->gridWidth(), CORRIDOR_WINDOW_ROWS, true);
+        for (int row = 0; row < CORRIDOR_WINDOW_ROWS; ++row)
+            corridor->nextRow(maze, row);
+        camX = spacing * 1.5f;
+        previousCamera.x = camX;
+    } else if (algoName) {
+        MazeAlgorithm algorithm;
+        if (!parseAlgorithm(algoName, algorithm) || rooms <= 0) {
+            std::cerr << "Usage: --generate backtracker|kruskal|wilson|prim --size <rooms> --seed <n>\n";
+            return false;
+        }
+        generateMaze(maze, rooms, rooms, algorithm, seed);
+        camX = spacing * 1.5f; // in front of the entrance at column 1
+        previousCamera.x = camX;
+    }
+
+    if (pvsPath) {
+        if (corridor) {
+            std::cerr << "--pvs is ignored in endless mode, the maze keeps changing\n";
+        } else if (!pvs.load(pvsPath, maze)) {
+            std::cout << "Building PVS for " << maze.width() << "x" << maze.height() << " maze...\n";
+            double start = glfwGetTime();
+            pvs.build(maze, VIEW_DISTANCE / spacing);
+            std::cout << "PVS built in " << glfwGetTime() - start << " s, "
+                      << pvs.memoryBytes() / 1024 << " KB\n";
+            pvs.save(pvsPath);
+        }
+    }
+
+    if (profilePath)
+        Profiler::enable();
+
+    if (replayPath) {
+        if (recordPath) {
+            std::cerr << "--record and --replay cannot be used together\n";
+            return false;
+        }
+        if (!inputLog.load(replayPath, maze.width(), maze.height()))
+            return false;
+        replaying = true;
+    }
+
+    if (crowdSize > 0) {
+        int exitRow, exitCol;
+        if (corridor) {
+            std::cerr << "--crowd is ignored in endless mode, there is no exit\n";
+        } else if (!findExit(maze, exitRow, exitCol)) {
+            std::cerr << "--crowd needs an opening in the outer wall to walk to\n";
+        } else {
+            crowd.reset(new Crowd());
+            int goal = crowd->addGoal(maze, exitRow, exitCol);
+            crowd->spawn(maze, spacing, crowdSize, goal, seed);
+        }
+    }
+    return true;
+}
+
+// The exit is the first opening in the bottom row, else anywhere in the outer wall
+bool findExit(const Maze& m, int& row, int& col) {
+    const int last = m.height() - 1;
+    for (int c = 0; c < m.width(); ++c) {
+        if (!m.isWall(last, c)) {
+            row = last;
+            col = c;
+            return true;
+        }
+    }
+    for (int r = 0; r < m.height(); ++r) {
+        for (int c = 0; c < m.width(); ++c) {
+            bool border = r == 0 || r == last || c == 0 || c == m.width() - 1;
+            if (border && !m.isWall(r, c)) {
+                row = r;
+                col = c;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// --- Endless corridor streaming ---
+void advanceCorridor() {
+    int row = static_cast<int>(-camZ / spacing);
+    if (row < CORRIDOR_WINDOW_ROWS - CORRIDOR_SCROLL_ROWS)
+        return;
+
+    maze.scrollRows(CORRIDOR_SCROLL_ROWS);
+    // Row 0 used to be inside the maze; cells outside the grid read as open,
+    // so seal it or a player turning back walks off the top of the window
+    for (int c = 0; c < maze.width(); ++c)
+        maze.setWall(0, c, true);
+    for (int r = CORRIDOR_WINDOW_ROWS - CORRIDOR_SCROLL_ROWS; r < CORRIDOR_WINDOW_ROWS; ++r)
+        corridor->nextRow(maze, r);
+    camZ += CORRIDOR_SCROLL_ROWS * spacing;
+    previousCamera.z += CORRIDOR_SCROLL_ROWS * spacing; // keep the blend on the same side of the shift
+    rebuildMaze();
+}
 
+// --- Culling counters, shown in the window title once per second ---
+// With -DMAZE_GL_STATS the last frame's GL call counts are logged as well
+void reportCullStats(GLFWwindow* window, float now) {
+    static float lastReport = 0.0f;
+    if (now - lastReport < 1.0f)
+        return;
+    lastReport = now;
+
+    const CullStats& stats = mazeCullStats();
+    char title[200];
+    snprintf(title, sizeof(title),
+             "3D Maze - Phong | chunks %d/%d drawn | wall cells frustum-culled %d, occluded %d of %d | %d walls in sight",
+             stats.chunksDrawn, stats.chunksTested, stats.cellsCulled, stats.cellsOccluded, stats.cellsTested,
+             inSight->visibleWallCells());
+    glfwSetWindowTitle(window, title);
+
+    if (GlCallStats::ENABLED) {
+        char calls[256];
+        GlCallStats::format(GlCallStats::lastFrame(), calls, sizeof(calls));
+        std::cout << "GL calls per frame: " << calls << "\n";
+    }
+}
+
+// --- Keyboard input, sampled once per frame ---
+void processInput(GLFWwindow* window) {
     if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
 
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) {
+    // F12 writes the profile recorded so far
+    static bool traceKeyHeld = false;
+    bool traceKey = glfwGetKey(window, GLFW_KEY_F12) == GLFW_PRESS;
+    if (traceKey && !traceKeyHeld && profilePath)
+        Profiler::writeChromeTrace(profilePath);
+    traceKeyHeld = traceKey;
+
+    input.forward = glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS;
+    input.back = glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS;
+    input.left = glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS;
+    input.right = glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS;
+}
+
+// --- Input recording and replay ---
+// Overrides the frame's input and elapsed time with the log's; false once
+// the log is used up
+bool replayFrame(std::size_t frame, float& frameSeconds) {
+    if (frame >= inputLog.size())
+        return false;
+    uint8_t keys = inputLog.frameKeys(frame);
+    input.forward = keys & KEY_FORWARD;
+    input.back = keys & KEY_BACK;
+    input.left = keys & KEY_LEFT;
+    input.right = keys & KEY_RIGHT;
+    frameSeconds = inputLog.frameSeconds(frame);
+    return true;
+}
+
+void recordFrame(float frameSeconds) {
+    if (!recordPath)
+        return;
+    uint8_t keys = (input.forward ? KEY_FORWARD : 0) | (input.back ? KEY_BACK : 0) |
+                   (input.left ? KEY_LEFT : 0) | (input.right ? KEY_RIGHT : 0);
+    inputLog.add(frameSeconds, keys);
+}
+
+// --- One fixed simulation step ---
+void simulate(float dt) {
+    PROFILE_SCOPE("simulation step");
+    previousCamera = { camX, camZ, yaw };
+
+    float moveSpeed = speedForward * dt;
+    float turnSpeed = speedTurn * dt;
+
+    float deltaX = 0.0f, deltaZ = 0.0f;
+    if (input.forward) {
         deltaX = frontX * moveSpeed;
         deltaZ = frontZ * moveSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
+    if (input.back) {
         deltaX = -frontX * moveSpeed;
         deltaZ = -frontZ * moveSpeed;
     }
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS) yaw -= turnSpeed;
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS) yaw += turnSpeed;
+    if (input.left) yaw -= turnSpeed;
+    if (input.right) yaw += turnSpeed;
 
     frontX = cos(glm::radians(pitch)) * cos(glm::radians(yaw));
     frontY = 0.0f;
     frontZ = cos(glm::radians(pitch)) * sin(glm::radians(yaw));
 
-    if (!checkCollision(camX + deltaX, camZ + deltaZ, spacing)) {
-        camX += deltaX;
-        camZ += deltaZ;
-    }
+    // Swept circle against the grid: slides along walls instead of stopping
+    CircleMove move = moveCircle(maze, spacing, camX, camZ, deltaX, deltaZ, CAMERA_RADIUS);
+    camX = move.position.x;
+    camZ = move.position.y;
+
+    if (crowd)
+        crowd->update(maze, spacing, dt);
+    if (corridor)
+        advanceCorridor();
+}
+
+// Yaw is never wrapped here, so a plain blend takes the short way round
+CameraState interpolateCamera(float alpha) {
+    CameraState state;
+    state.x = previousCamera.x + (camX - previousCamera.x) * alpha;
+    state.z = previousCamera.z + (camZ - previousCamera.z) * alpha;
+    state.yaw = previousCamera.yaw + (yaw - previousCamera.yaw) * alpha;
+    return state;
 }
 
 // --- Window resize callback ---
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
 }
-
-// --- Shader loader ---
-GLuint loadShader(const char* vertexPath, const char* fragmentPath) {
-    std::ifstream vFile(vertexPath), fFile(fragmentPath);
-    std::stringstream vStream, fStream;
-    vStream << vFile.rdbuf();
-    fStream << fFile.rdbuf();
-
-    std::string vCode = vStream.str();
-    std::string fCode = fStream.str();
-    const char* vShaderCode = vCode.c_str();
-    const char* fShaderCode = fCode.c_str();
-
-    GLuint vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vShaderCode, nullptr);
-    glCompileShader(vertex);
-
-    GLuint fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fShaderCode, nullptr);
-    glCompileShader(fragment);
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vertex);
-    glAttachShader(program, fragment);
-    glLinkProgram(program);
-
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
-    return program;
-}
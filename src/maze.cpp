@@ -1,14 +1,29 @@
 #include "maze.h"
+#include "chunk.h"
+#include "culling.h"
+#include "visibility.h"
+#include "shader.h"
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
-unsigned int VAO, VBO;
+ChunkManager chunks;
+CullStats cullStats;
+
+// Scratch for per-frame culling, reused to avoid allocations
+static BoxList chunkBoxes;
+static std::vector<const MazeChunk*> chunkList;
+static std::vector<uint8_t> chunkVisible;
 unsigned int floorVAO, floorVBO;
+
+// Static transforms and their normal matrices, computed once in initMaze()
+glm::mat4 wallModel(1.0f), floorModel(1.0f);
+glm::mat3 wallNormalMatrix(1.0f), floorNormalMatrix(1.0f);
 extern const float spacing = 4.0f;
 
-int maze[MAZE_SIZE][MAZE_SIZE] = {
+static const int defaultLayout[20][20] = {
     {1,1,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1},
     {1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1},
     {1,0,0,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1},
@@ -31,62 +46,10 @@ int maze[MAZE_SIZE][MAZE_SIZE] = {
     {1,1,1,1,1,1,1,1,1,0,0,1,1,1,1,1,1,1,1,1}
 };
 
-float vertices[] = {
-    // positions         // normals
-    -0.5f,-0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-     0.5f,-0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-     0.5f, 0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-     0.5f, 0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-    -0.5f, 0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-    -0.5f,-0.5f,-0.5f,  0.0f, 0.0f,-1.0f,
-
-    -0.5f,-0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-     0.5f,-0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-     0.5f, 0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-     0.5f, 0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-    -0.5f, 0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-    -0.5f,-0.5f, 0.5f,  0.0f, 0.0f, 1.0f,
-
-    -0.5f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f,
-    -0.5f, 0.5f,-0.5f, -1.0f, 0.0f, 0.0f,
-    -0.5f,-0.5f,-0.5f, -1.0f, 0.0f, 0.0f,
-    -0.5f,-0.5f,-0.5f, -1.0f, 0.0f, 0.0f,
-    -0.5f,-0.5f, 0.5f, -1.0f, 0.0f, 0.0f,
-    -0.5f, 0.5f, 0.5f, -1.0f, 0.0f, 0.0f,
-
-     0.5f, 0.5f, 0.5f,  1.0f, 0.0f, 0.0f,
-     0.5f, 0.5f,-0.5f,  1.0f, 0.0f, 0.0f,
-     0.5f,-0.5f,-0.5f,  1.0f, 0.0f, 0.0f,
-     0.5f,-0.5f,-0.5f,  1.0f, 0.0f, 0.0f,
-     0.5f,-0.5f, 0.5f,  1.0f, 0.0f, 0.0f,
-     0.5f, 0.5f, 0.5f,  1.0f, 0.0f, 0.0f,
-
-    -0.5f,-0.5f,-0.5f,  0.0f,-1.0f, 0.0f,
-     0.5f,-0.5f,-0.5f,  0.0f,-1.0f, 0.0f,
-     0.5f,-0.5f, 0.5f,  0.0f,-1.0f, 0.0f,
-     0.5f,-0.5f, 0.5f,  0.0f,-1.0f, 0.0f,
-    -0.5f,-0.5f, 0.5f,  0.0f,-1.0f, 0.0f,
-    -0.5f,-0.5f,-0.5f,  0.0f,-1.0f, 0.0f,
-
-    -0.5f, 0.5f,-0.5f,  0.0f, 1.0f, 0.0f,
-     0.5f, 0.5f,-0.5f,  0.0f, 1.0f, 0.0f,
-     0.5f, 0.5f, 0.5f,  0.0f, 1.0f, 0.0f,
-     0.5f, 0.5f, 0.5f,  0.0f, 1.0f, 0.0f,
-    -0.5f, 0.5f, 0.5f,  0.0f, 1.0f, 0.0f,
-    -0.5f, 0.5f,-0.5f,  0.0f, 1.0f, 0.0f
-};
+Maze maze = Maze::fromCells(&defaultLayout[0][0], 20, 20);
 
 void initMaze() {
-    // Wall VAO/VBO
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    // Walls are baked per chunk as the camera moves (see updateMaze)
 
     // Floor plane
     float floorVertices[] = {
@@ -108,38 +71,78 @@ void initMaze() {
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
+
+    rebuildMaze();
 }
 
-void drawMaze(unsigned int shaderProgram) {
-    // Draw walls
-    glBindVertexArray(VAO);
-    for (int i = 0; i < MAZE_SIZE; ++i) {
-        for (int j = 0; j < MAZE_SIZE; ++j) {
-            if (maze[i][j] == 1) {
-                glm::mat4 model = glm::mat4(1.0f);
-                float x = j * spacing + spacing / 2.0f;
-                float z = -i * spacing - spacing / 2.0f;
-                model = glm::translate(model, glm::vec3(x, (spacing * 10.0f) / 2.0f, z));
-                model = glm::scale(model, glm::vec3(spacing, spacing * 10.0f, spacing));
-                glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-                glDrawArrays(GL_TRIANGLES, 0, 36);
-            }
+void rebuildMaze() {
+    chunks.invalidate();
+
+    // Walls are baked in world space; the floor is a translate + axis-aligned scale
+    wallModel = glm::mat4(1.0f);
+    wallNormalMatrix = glm::mat3(1.0f);
+    float extentX = maze.width() * spacing, extentZ = maze.height() * spacing;
+    floorModel = glm::translate(glm::mat4(1.0f), glm::vec3(extentX / 2.0f, 0.0f, -extentZ / 2.0f));
+    floorModel = glm::scale(floorModel, glm::vec3(extentX + 8.0f, 1.0f, extentZ + 8.0f));
+    floorNormalMatrix = glm::inverseTranspose(glm::mat3(floorModel));
+}
+
+void updateMaze(float camX, float camZ) {
+    chunks.update(maze, spacing, camX, camZ);
+}
+
+const CullStats& mazeCullStats() {
+    return cullStats;
+}
+
+void drawMaze(const ShaderProgram& shader, const glm::mat4& viewProjection,
+              const CellVisibility& visibility) {
+    const GLint modelLoc = shader.modelLocation();
+    const GLint normalLoc = shader.normalMatrixLocation();
+
+    // Frustum-cull the resident chunks against their wall bounds
+    chunkBoxes.clear();
+    chunkList.clear();
+    for (const auto& entry : chunks.resident()) {
+        const MazeChunk& chunk = entry.second;
+        if (chunk.vertexCount == 0) continue;
+        chunkBoxes.add(chunk.boundsMin, chunk.boundsMax);
+        chunkList.push_back(&chunk);
+    }
+    chunkVisible.resize(chunkList.size());
+    cullBoxes(extractFrustum(viewProjection), chunkBoxes, chunkVisible.data());
+
+    // Draw walls: one world-space mesh per visible, unoccluded chunk
+    cullStats = CullStats();
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(wallModel));
+    glUniformMatrix3fv(normalLoc, 1, GL_FALSE, glm::value_ptr(wallNormalMatrix));
+    for (std::size_t i = 0; i < chunkList.size(); ++i) {
+        const MazeChunk& chunk = *chunkList[i];
+        ++cullStats.chunksTested;
+        cullStats.cellsTested += chunk.wallCells;
+        if (!chunkVisible[i]) {
+            cullStats.cellsCulled += chunk.wallCells;
+            continue;
+        }
+        if (!visibility.anyVisibleIn(chunk.row0, chunk.col0, chunk.rows, chunk.cols)) {
+            ++cullStats.chunksOccluded;
+            cullStats.cellsOccluded += chunk.wallCells;
+            continue;
         }
+        ++cullStats.chunksDrawn;
+        glBindVertexArray(chunk.vao);
+        glDrawArrays(GL_TRIANGLES, 0, chunk.vertexCount);
     }
 
     // Draw floor
     glBindVertexArray(floorVAO);
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::translate(model, glm::vec3(MAZE_SIZE * spacing / 2.0f, 0.0f, -MAZE_SIZE * spacing / 2.0f));
-    model = glm::scale(model, glm::vec3(MAZE_SIZE * spacing + 8.0f, 1.0f, MAZE_SIZE * spacing + 8.0f));
-    glUniformMatrix4fv(glGetUniformLocation(shaderProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(floorModel));
+    glUniformMatrix3fv(normalLoc, 1, GL_FALSE, glm::value_ptr(floorNormalMatrix));
     glDrawArrays(GL_TRIANGLES, 0, 6);
 }
 
 bool checkCollision(float x, float z, float spacing) {
     int col = static_cast<int>(x / spacing);
     int row = static_cast<int>(-z / spacing);
-    if (row < 0 || row >= MAZE_SIZE || col < 0 || col >= MAZE_SIZE)
-        return false;
-    return maze[row][col] == 1;
+    return maze.isWall(row, col);
 }
\ No newline at end of file
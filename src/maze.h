@@ -1,10 +1,27 @@
 #ifndef MAZE_H
 #define MAZE_H
 
-#define MAZE_SIZE 20
+#include "culling.h"
+#include "maze_grid.h"
+#include <glm/glm.hpp>
+
+class CellVisibility;
+class ShaderProgram;
+
+// The level currently loaded; initMaze() builds its geometry
+extern Maze maze;
 
 void initMaze();
-void drawMaze(unsigned int shaderProgram);
+// Re-bake the wall mesh and floor after the maze grid has changed
+void rebuildMaze();
+// Stream wall chunks in and out around the camera; call once per frame
+void updateMaze(float camX, float camZ);
+// Draw the chunks that survive frustum culling against viewProjection and
+// contain at least one cell the visibility pass reached
+void drawMaze(const ShaderProgram& shader, const glm::mat4& viewProjection,
+              const CellVisibility& visibility);
+// Counters from the most recent drawMaze()
+const CullStats& mazeCullStats();
 bool checkCollision(float x, float z, float spacing);
 
 #endif
@@ -0,0 +1,97 @@
+#include "maze_grid.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+static int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<int>((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+Maze::Maze(int width, int height, bool wall) {
+    resize(width, height, wall);
+}
+
+Maze Maze::fromCells(const int* cells, int width, int height) {
+    Maze m(width, height);
+    for (int r = 0; r < height; ++r)
+        for (int c = 0; c < width; ++c)
+            if (cells[r * width + c] != 0)
+                m.setWall(r, c, true);
+    return m;
+}
+
+bool Maze::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open maze file " << path << "\n";
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    std::string line;
+    std::size_t longest = 0;
+    while (std::getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.size() > longest) longest = line.size();
+        lines.push_back(line);
+    }
+    if (lines.empty() || longest == 0) {
+        std::cerr << "Maze file " << path << " is empty\n";
+        return false;
+    }
+
+    resize(static_cast<int>(longest), static_cast<int>(lines.size()));
+    for (int r = 0; r < h; ++r) {
+        const std::string& row = lines[r];
+        for (int c = 0; c < static_cast<int>(row.size()); ++c)
+            if (row[c] == '#' || row[c] == '1')
+                setWall(r, c, true);
+    }
+    return true;
+}
+
+void Maze::resize(int width, int height, bool wall) {
+    w = width;
+    h = height;
+    stride = (static_cast<std::size_t>(width) + 63) / 64;
+    bits.assign(stride * height, wall ? ~uint64_t(0) : 0);
+    clearPadding();
+}
+
+void Maze::fill(bool wall) {
+    std::fill(bits.begin(), bits.end(), wall ? ~uint64_t(0) : 0);
+    clearPadding();
+}
+
+void Maze::scrollRows(int count) {
+    if (count <= 0) return;
+    if (count >= h) {
+        fill(false);
+        return;
+    }
+    std::size_t shift = static_cast<std::size_t>(count) * stride;
+    std::copy(bits.begin() + shift, bits.end(), bits.begin());
+    std::fill(bits.end() - shift, bits.end(), 0);
+}
+
+void Maze::clearPadding() {
+    int tail = w & 63;
+    if (tail == 0 || stride == 0) return;
+    uint64_t mask = (uint64_t(1) << tail) - 1;
+    for (int r = 0; r < h; ++r)
+        bits[r * stride + stride - 1] &= mask;
+}
+
+std::size_t Maze::wallCount() const {
+    std::size_t count = 0;
+    for (uint64_t word : bits)
+        count += popcount64(word);
+    return count;
+}
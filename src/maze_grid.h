@@ -0,0 +1,63 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Runtime-sized maze grid, one bit per cell (1 = wall, 0 = open).
+// Rows are packed into 64-bit words; bit (col % 64) of word (col / 64)
+// in a row holds the cell, so a whole row can be scanned a word at a time.
+// Row r lies along world -Z (z = -r * spacing), column c along +X.
+class Maze {
+public:
+    Maze() = default;
+    Maze(int width, int height, bool wall = false);
+
+    // Build from a row-major array of 0/1 cells
+    static Maze fromCells(const int* cells, int width, int height);
+    // Text format: one line per row, '#' or '1' is a wall, anything else open
+    bool loadFromFile(const std::string& path);
+
+    int width() const { return w; }
+    int height() const { return h; }
+    bool inBounds(int row, int col) const {
+        return row >= 0 && row < h && col >= 0 && col < w;
+    }
+
+    // Cells outside the grid read as open
+    bool isWall(int row, int col) const {
+        if (!inBounds(row, col)) return false;
+        return (bits[row * stride + (col >> 6)] >> (col & 63)) & 1u;
+    }
+    void setWall(int row, int col, bool wall) {
+        uint64_t& word = bits[row * stride + (col >> 6)];
+        uint64_t mask = uint64_t(1) << (col & 63);
+        word = wall ? (word | mask) : (word & ~mask);
+    }
+    void fill(bool wall);
+    void resize(int width, int height, bool wall = false);
+    // Drop the first `count` rows, moving the rest up; the freed rows at the
+    // bottom are cleared to open so the caller can refill them
+    void scrollRows(int count);
+
+    // Raw row access for word-level scans; bits past width() are always zero
+    std::size_t wordsPerRow() const { return stride; }
+    const uint64_t* rowWords(int row) const { return bits.data() + row * stride; }
+    // All rows back to back (height() * wordsPerRow() words)
+    const uint64_t* words() const { return bits.data(); }
+    uint64_t* rowWords(int row) { return bits.data() + row * stride; }
+
+    std::size_t wallCount() const;
+    std::size_t memoryBytes() const { return bits.size() * sizeof(uint64_t); }
+
+private:
+    void clearPadding();
+
+    int w = 0, h = 0;
+    std::size_t stride = 0; // 64-bit words per row
+    std::vector<uint64_t> bits;
+};
+
+#endif
@@ -2,7 +2,13 @@
 #include <cmath>
 #include <set>
 #include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <stdio.h>
+#include "fixed_step.h"
+#include "frame_stats.h"
+#include "gl_stats.h"
+#include "headless.h"
 
 // Maze size
 const int WIDTH = 10, HEIGHT = 6;
@@ -37,18 +43,62 @@ std::set<unsigned char> pressedKeys;
 // Timing
 auto lastTime = std::chrono::high_resolution_clock::now();
 
+const int WINDOW_WIDTH = 900, WINDOW_HEIGHT = 700;
+
+// --headless <frames>: draw that many frames offscreen in a compatibility
+// context, print the frame time statistics and exit
+bool headless = false;
+int headlessFrames = 0;
+
+// Movement and the transition advance in fixed steps; frames draw the
+// camera blended between the last two steps
+FixedTimestep timestep(120.0);
+float prevX = cameraX, prevY = cameraY, prevZ = cameraZ;
+float prevYaw = cameraYaw, prevPitch = cameraPitch;
+
+void savePreviousCamera() {
+    prevX = cameraX;
+    prevY = cameraY;
+    prevZ = cameraZ;
+    prevYaw = cameraYaw;
+    prevPitch = cameraPitch;
+}
+
 // Smooth interpolation function with more dramatic easing
 float smoothstep(float t) {
     // More dramatic easing curve
     return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
 }
 
+// Unit cube around the origin. GLUT refuses to draw without glutInit(),
+// which needs a display, so headless runs draw the same six quads here.
+void solidCube() {
+    if (!headless) {
+        glutSolidCube(1.0f);
+        return;
+    }
+    // Corner i sits at x = bit 2, y = bit 1, z = bit 0 xor bit 1; faces as in GLUT
+    static const float normals[6][3] = {
+        { -1, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 }
+    };
+    static const int faces[6][4] = {
+        { 0, 1, 2, 3 }, { 3, 2, 6, 7 }, { 7, 6, 5, 4 }, { 4, 5, 1, 0 }, { 5, 6, 2, 1 }, { 7, 4, 0, 3 }
+    };
+    glBegin(GL_QUADS);
+    for (int f = 0; f < 6; ++f) {
+        glNormal3f(normals[f][0], normals[f][1], normals[f][2]);
+        for (int i : faces[f])
+            glVertex3f((i & 4) ? 0.5f : -0.5f, (i & 2) ? 0.5f : -0.5f, ((i ^ (i >> 1)) & 1) ? 0.5f : -0.5f);
+    }
+    glEnd();
+}
+
 // Draw a proper cube wall at specific position
 void drawWallCube(float x, float y, float z, float width, float height, float depth) {
     glPushMatrix();
     glTranslatef(x, y, z);
     glScalef(width, height, depth);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
 }
 
@@ -177,7 +227,7 @@ void drawEntrance() {
     glPushMatrix();
     glTranslatef(-0.3f, 0.1f, 6.0f);
     glScalef(0.2f, 0.2f, 2.0f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     // Entrance door frame
@@ -185,27 +235,27 @@ void drawEntrance() {
     glPushMatrix();
     glTranslatef(-0.1f, 1.0f, 6.0f);
     glScalef(0.2f, 2.0f, 0.1f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     // Door frame sides
     glPushMatrix();
     glTranslatef(-0.1f, 1.0f, 5.0f);
     glScalef(0.2f, 2.0f, 0.1f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     glPushMatrix();
     glTranslatef(-0.1f, 1.0f, 7.0f);
     glScalef(0.2f, 2.0f, 0.1f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     // Door frame top
     glPushMatrix();
     glTranslatef(-0.1f, 2.0f, 6.0f);
     glScalef(0.2f, 0.1f, 2.0f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     // Welcome mat
@@ -213,7 +263,7 @@ void drawEntrance() {
     glPushMatrix();
     glTranslatef(-0.5f, 0.02f, 6.0f);
     glScalef(1.0f, 0.05f, 2.0f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
 }
 
@@ -252,7 +302,7 @@ void drawMaze() {
     glPushMatrix();
     glTranslatef(WIDTH*2.0f + 0.3f, 0.1f, (HEIGHT-1)*2.0f + 1.0f);
     glScalef(0.2f, 0.2f, 2.0f);
-    glutSolidCube(1.0f);
+    solidCube();
     glPopMatrix();
     
     // Add some trees around the perimeter for atmosphere
@@ -266,7 +316,7 @@ void drawMaze() {
         glPushMatrix();
         glTranslatef(x, 1.5f, z);
         glScalef(0.5f, 3.0f, 0.5f);
-        glutSolidCube(1.0f);
+        solidCube();
         glPopMatrix();
     }
 }
@@ -349,20 +399,38 @@ void updateTransition(float deltaTime) {
     }
 }
 
-// Camera setup
-void updateCamera() {
-    float rad = cameraYaw * 3.14159f / 180.0f;
-    float pitchRad = cameraPitch * 3.14159f / 180.0f;
+// Camera setup, alpha of the way from the previous step to the latest
+void updateCamera(float alpha) {
+    float x = prevX + (cameraX - prevX) * alpha;
+    float y = prevY + (cameraY - prevY) * alpha;
+    float z = prevZ + (cameraZ - prevZ) * alpha;
+    float pitch = prevPitch + (cameraPitch - prevPitch) * alpha;
+    // Yaw wraps at 360, so blend across the short way round
+    float turn = cameraYaw - prevYaw;
+    if (turn > 180.0f) turn -= 360.0f;
+    if (turn < -180.0f) turn += 360.0f;
+    float yaw = prevYaw + turn * alpha;
+
+    float rad = yaw * 3.14159f / 180.0f;
+    float pitchRad = pitch * 3.14159f / 180.0f;
     
     float dirX = cos(rad) * cos(pitchRad);
     float dirY = sin(pitchRad);
     float dirZ = sin(rad) * cos(pitchRad);
     
-    gluLookAt(cameraX, cameraY, cameraZ,
-              cameraX + dirX, cameraY + dirY, cameraZ + dirZ,
+    gluLookAt(x, y, z,
+              x + dirX, y + dirY, z + dirZ,
               0.0f, 1.0f, 0.0f);
 }
 
+// Clear and draw the maze from the camera blended alpha of the way to the latest step
+void renderFrame(float alpha) {
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glLoadIdentity();
+    updateCamera(alpha);
+    drawMaze();
+}
+
 // GLUT display callback
 void display() {
     // Calculate delta time
@@ -371,17 +439,26 @@ void display() {
     float deltaTime = duration.count() / 1000000.0f;
     lastTime = currentTime;
     
-    // Update transition and movement
-    updateTransition(deltaTime);
-    updateMovement(deltaTime);
-    
-    // Clear screen
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    glLoadIdentity();
-    updateCamera();
-    drawMaze();
+    // Update transition and movement in fixed steps
+    for (int steps = timestep.advance(deltaTime); steps > 0; --steps) {
+        savePreviousCamera();
+        updateTransition(timestep.step());
+        updateMovement(timestep.step());
+    }
     
+    renderFrame(timestep.alpha());
     glutSwapBuffers();
+    GlCallStats::endFrame();
+
+    // With -DMAZE_GL_STATS, log the GL calls of a frame once per second
+    static float sinceReport = 0.0f;
+    sinceReport += deltaTime;
+    if (GlCallStats::ENABLED && sinceReport >= 1.0f) {
+        sinceReport = 0.0f;
+        char calls[256];
+        GlCallStats::format(GlCallStats::lastFrame(), calls, sizeof(calls));
+        printf("GL calls per frame: %s\n", calls);
+    }
 }
 
 // Keyboard down event
@@ -397,6 +474,7 @@ void keyboardDown(unsigned char key, int x, int y) {
         cameraZ = endZ;
         cameraYaw = endYaw;
         cameraPitch = endPitch;
+        savePreviousCamera(); // cut straight to the end, no blend
         printf("Transition skipped!\n");
     }
 }
@@ -522,10 +600,55 @@ void initGL() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
+// Fixed 1/60 s frames: the cinematic descent, then turning on the spot
+int runHeadless() {
+    HeadlessContext context;
+    if (!context.createContext(true) || !context.createFramebuffer(WINDOW_WIDTH, WINDOW_HEIGHT))
+        return 1;
+    printf("Headless: %s, %dx%d\n", reinterpret_cast<const char*>(glGetString(GL_RENDERER)),
+           WINDOW_WIDTH, WINDOW_HEIGHT);
+
+    initGL();
+    initMaze();
+    reshape(WINDOW_WIDTH, WINDOW_HEIGHT);
+    pressedKeys.insert('e');
+
+    using Clock = std::chrono::steady_clock;
+    FrameStats stats;
+    for (int frame = 0; frame < headlessFrames; ++frame) {
+        Clock::time_point start = Clock::now();
+        for (int steps = timestep.advance(1.0f / 60.0f); steps > 0; --steps) {
+            savePreviousCamera();
+            updateTransition(timestep.step());
+            updateMovement(timestep.step());
+        }
+        renderFrame(timestep.alpha());
+        glFinish();
+        GlCallStats::endFrame();
+        stats.add(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    stats.print("Headless");
+    if (GlCallStats::ENABLED) {
+        char calls[256];
+        GlCallStats::format(GlCallStats::lastFrame(), calls, sizeof(calls));
+        printf("Last frame GL calls: %s\n", calls);
+    }
+    return 0;
+}
+
 int main(int argc, char** argv) {
+    for (int i = 1; i + 1 < argc; ++i) {
+        if (!std::strcmp(argv[i], "--headless")) {
+            headless = true;
+            headlessFrames = std::atoi(argv[++i]);
+        }
+    }
+    if (headless)
+        return runHeadless();
+
     glutInit(&argc, argv);
     glutInitDisplayMode(GLUT_DOUBLE | GLUT_RGB | GLUT_DEPTH);
-    glutInitWindowSize(900, 700);
+    glutInitWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
     glutCreateWindow("3D Maze - Cinematic Transition");
 
     initGL();
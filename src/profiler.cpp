@@ -0,0 +1,85 @@
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+std::atomic<bool> Profiler::active{ false };
+
+// Every ring ever created; rings outlive their threads so a trace written
+// at exit still has them
+static std::mutex ringsMutex;
+static std::vector<std::unique_ptr<ProfileRing>> rings;
+static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+ProfileRing::ProfileRing(std::string name, std::size_t capacity)
+    : trackName(std::move(name)), events(capacity), mask(capacity - 1) {}
+
+void ProfileRing::snapshot(std::vector<ProfileEvent>& out) const {
+    const uint64_t end = head.load(std::memory_order_acquire);
+    const uint64_t begin = end > events.size() ? end - events.size() : 0;
+    for (uint64_t i = begin; i < end; ++i)
+        out.push_back(events[i & mask]);
+}
+
+void Profiler::enable() {
+    threadRing(); // the enabling thread is listed first
+    active.store(true, std::memory_order_relaxed);
+}
+
+// Never 0, which ProfileScope uses for "not started"
+uint64_t Profiler::now() {
+    auto elapsed = std::chrono::steady_clock::now() - epoch;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) + 1;
+}
+
+ProfileRing& Profiler::threadRing() {
+    thread_local ProfileRing* ring = nullptr;
+    if (!ring) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        std::string name = rings.empty() ? "Main thread" : "Thread " + std::to_string(rings.size());
+        rings.emplace_back(new ProfileRing(name, RING_CAPACITY));
+        ring = rings.back().get();
+    }
+    return *ring;
+}
+
+ProfileRing& Profiler::namedRing(const char* name) {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    for (auto& ring : rings)
+        if (ring->name() == name)
+            return *ring;
+    rings.emplace_back(new ProfileRing(name, RING_CAPACITY));
+    return *rings.back();
+}
+
+// --- Chrome trace export ---
+// Complete ("X") events with microsecond timestamps, one track per ring
+bool Profiler::writeChromeTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        std::cerr << "Failed to write trace " << path << "\n";
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    std::vector<ProfileEvent> events;
+    std::size_t written = 0;
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    for (std::size_t track = 0; track < rings.size(); ++track) {
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+                     track ? ",\n" : "", track, rings[track]->name().c_str());
+        events.clear();
+        rings[track]->snapshot(events);
+        for (const ProfileEvent& e : events)
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                         e.name, track, e.startNs / 1000.0, e.durationNs / 1000.0);
+        written += events.size();
+    }
+    std::fprintf(file, "\n]}\n");
+    bool ok = std::fclose(file) == 0;
+    std::cout << "Wrote " << written << " profile events to " << path << "\n";
+    return ok;
+}
@@ -0,0 +1,86 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One timed section; name must be a string literal (only the pointer is kept)
+struct ProfileEvent {
+    const char* name;
+    uint64_t startNs;     // since Profiler::enable()
+    uint64_t durationNs;
+};
+
+// The latest events of one thread (or one GPU timeline). Only the owning
+// thread pushes; older events are overwritten once the ring is full.
+class ProfileRing {
+public:
+    ProfileRing(std::string name, std::size_t capacity);
+
+    void push(const ProfileEvent& event) {
+        uint64_t index = head.load(std::memory_order_relaxed);
+        events[index & mask] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+
+    const std::string& name() const { return trackName; }
+    // Copy out the events still in the ring, oldest first
+    void snapshot(std::vector<ProfileEvent>& out) const;
+
+private:
+    std::string trackName;
+    std::vector<ProfileEvent> events;
+    uint64_t mask;
+    std::atomic<uint64_t> head{ 0 };
+};
+
+// Frame profiler: scoped CPU timers recorded into per-thread rings, plus
+// any extra timelines (GPU timer queries), exported as Chrome trace JSON
+// for chrome://tracing or Perfetto. Off until enable(); disabled scopes
+// cost one relaxed atomic load.
+class Profiler {
+public:
+    static void enable();
+    static bool enabled() { return active.load(std::memory_order_relaxed); }
+    static uint64_t now();
+
+    // This thread's ring, created and named after the first call
+    static ProfileRing& threadRing();
+    // A timeline that is not a thread, e.g. "GPU"
+    static ProfileRing& namedRing(const char* name);
+
+    // Write every ring as a trace. Call between frames, while worker threads
+    // are idle, so no ring wraps during the copy.
+    static bool writeChromeTrace(const std::string& path);
+
+    static const std::size_t RING_CAPACITY = 1 << 14;
+
+private:
+    static std::atomic<bool> active;
+};
+
+// Times the enclosing block into this thread's ring
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : name(name), start(Profiler::enabled() ? Profiler::now() : 0) {}
+    ~ProfileScope() {
+        if (start != 0 && Profiler::enabled())
+            Profiler::threadRing().push({ name, start, Profiler::now() - start });
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+#endif
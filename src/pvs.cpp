@@ -0,0 +1,381 @@
+#include "pvs.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+static const uint32_t PVS_MAGIC = 0x5356504Du; // "MPVS"
+static const uint32_t PVS_VERSION = 3; // 3: exact from-cell visibility, older sets miss walls
+
+static uint64_t hashMaze(const Maze& m) {
+    uint64_t h = 1469598103934665603ull; // FNV-1a
+    auto mix = [&h](uint64_t v) {
+        for (int i = 0; i < 8; ++i) {
+            h ^= (v >> (i * 8)) & 0xff;
+            h *= 1099511628211ull;
+        }
+    };
+    mix(static_cast<uint64_t>(m.width()));
+    mix(static_cast<uint64_t>(m.height()));
+    for (int r = 0; r < m.height(); ++r)
+        for (std::size_t w = 0; w < m.wordsPerRow(); ++w)
+            mix(m.rowWords(r)[w]);
+    return h;
+}
+
+static void putVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+static uint32_t getVarint(const uint8_t*& p) {
+    uint32_t v = 0;
+    for (int shift = 0; ; shift += 7) {
+        uint8_t byte = *p++;
+        v |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+}
+
+// --- Build ---
+// A cell is in a set if some straight line from some point of the source
+// cell reaches it without crossing the inside of a wall cell, so the set
+// holds everything the camera can see from anywhere in the cell. Each
+// quadrant around the source is scanned with precise permissive field of
+// view (Duerig): cells are visited in diagonal order while a list of open
+// views, each bounded by a shallow and a steep line through wall corners,
+// is narrowed as walls are met.
+//
+// Quadrant coordinates are local: the source cell spans [0,1] x [0,1] and
+// cell (x, y) spans [x,x+1] x [y,y+1], so every line is exact in integers.
+struct ViewLine {
+    int xi, yi, xf, yf;
+
+    // > 0 if the line passes below the point, < 0 above it, 0 through it
+    int relativeSlope(int x, int y) const { return (yf - yi) * (xf - x) - (xf - xi) * (yf - y); }
+    bool isBelow(int x, int y) const { return relativeSlope(x, y) > 0; }
+    bool isBelowOrContains(int x, int y) const { return relativeSlope(x, y) >= 0; }
+    bool isAbove(int x, int y) const { return relativeSlope(x, y) < 0; }
+    bool isAboveOrContains(int x, int y) const { return relativeSlope(x, y) <= 0; }
+    bool contains(int x, int y) const { return relativeSlope(x, y) == 0; }
+};
+
+// Wall corner a view line was bent around; bumps form chains through parent
+struct ViewBump {
+    int x, y, parent;
+};
+
+struct View {
+    ViewLine shallow, steep;
+    int shallowBump, steepBump; // -1 when the line has not been bent
+};
+
+// Each worker owns a mark window around the cell being processed; marks
+// are generation stamps so the window never needs clearing.
+struct PvsWorker {
+    int radius = 0, size = 0;
+    std::vector<uint32_t> stamp;
+    uint32_t generation = 0;
+    std::vector<View> views;     // open views of the quadrant, shallow to steep
+    std::vector<ViewBump> bumps;
+};
+
+struct QuadrantScan {
+    const Maze& m;
+    PvsWorker& w;
+    int row, col, dx, dy;
+    int originRow, originCol;
+    float maxCells;
+
+    void addShallowBump(int x, int y, View& v) {
+        v.shallow.xf = x;
+        v.shallow.yf = y;
+        w.bumps.push_back({ x, y, v.shallowBump });
+        v.shallowBump = static_cast<int>(w.bumps.size()) - 1;
+        for (int b = v.steepBump; b >= 0; b = w.bumps[b].parent) {
+            if (v.shallow.isAbove(w.bumps[b].x, w.bumps[b].y)) {
+                v.shallow.xi = w.bumps[b].x;
+                v.shallow.yi = w.bumps[b].y;
+            }
+        }
+    }
+
+    void addSteepBump(int x, int y, View& v) {
+        v.steep.xf = x;
+        v.steep.yf = y;
+        w.bumps.push_back({ x, y, v.steepBump });
+        v.steepBump = static_cast<int>(w.bumps.size()) - 1;
+        for (int b = v.shallowBump; b >= 0; b = w.bumps[b].parent) {
+            if (v.steep.isBelow(w.bumps[b].x, w.bumps[b].y)) {
+                v.steep.xi = w.bumps[b].x;
+                v.steep.yi = w.bumps[b].y;
+            }
+        }
+    }
+
+    // Drops the view once its lines meet at a corner of the source cell,
+    // where it has no width left; returns false if it was dropped
+    bool checkView(std::size_t index) {
+        const View& v = w.views[index];
+        if (v.shallow.contains(v.steep.xi, v.steep.yi) && v.shallow.contains(v.steep.xf, v.steep.yf) &&
+            (v.shallow.contains(0, 1) || v.shallow.contains(1, 0))) {
+            w.views.erase(w.views.begin() + index);
+            return false;
+        }
+        return true;
+    }
+
+    void visit(int x, int y, std::size_t& current) {
+        const int topLeftX = x, topLeftY = y + 1, bottomRightX = x + 1, bottomRightY = y;
+        while (current < w.views.size() && w.views[current].steep.isBelowOrContains(bottomRightX, bottomRightY))
+            ++current;
+        if (current == w.views.size() || w.views[current].shallow.isAboveOrContains(topLeftX, topLeftY))
+            return;
+
+        // Gap between the source and this cell, to honour the view distance
+        const int r = row + y * dy, c = col + x * dx;
+        const float gapX = static_cast<float>(std::max(0, x - 1)), gapY = static_cast<float>(std::max(0, y - 1));
+        if (gapX * gapX + gapY * gapY <= maxCells * maxCells)
+            w.stamp[(r - originRow) * w.size + (c - originCol)] = w.generation;
+        if (!m.isWall(r, c)) return;
+
+        View& v = w.views[current];
+        const bool shallowAbove = v.shallow.isAbove(bottomRightX, bottomRightY);
+        const bool steepBelow = v.steep.isBelow(topLeftX, topLeftY);
+        if (shallowAbove && steepBelow) {
+            // The wall fills the view
+            w.views.erase(w.views.begin() + current);
+        } else if (shallowAbove) {
+            addShallowBump(topLeftX, topLeftY, v);
+            checkView(current);
+        } else if (steepBelow) {
+            addSteepBump(bottomRightX, bottomRightY, v);
+            checkView(current);
+        } else {
+            // The wall splits the view in two, either side of it
+            std::size_t shallowIndex = current, steepIndex = ++current;
+            View copy = v;
+            w.views.insert(w.views.begin() + shallowIndex, copy);
+            addSteepBump(bottomRightX, bottomRightY, w.views[shallowIndex]);
+            if (!checkView(shallowIndex)) {
+                --current;
+                --steepIndex;
+            }
+            addShallowBump(topLeftX, topLeftY, w.views[steepIndex]);
+            checkView(steepIndex);
+        }
+    }
+
+    void run(int extentX, int extentY) {
+        w.views.assign(1, View{ { 0, 1, extentX, 0 }, { 1, 0, 0, extentY }, -1, -1 });
+        w.bumps.clear();
+        for (int i = 1; i <= extentX + extentY && !w.views.empty(); ++i) {
+            std::size_t current = 0;
+            for (int j = std::max(0, i - extentX); j <= std::min(i, extentY) && current < w.views.size(); ++j)
+                visit(i - j, j, current);
+        }
+    }
+};
+
+static void buildCell(const Maze& m, int row, int col, float maxCells,
+                      PvsWorker& w, std::vector<uint8_t>& out) {
+    ++w.generation;
+    const int originRow = row - w.radius, originCol = col - w.radius;
+    w.stamp[w.radius * w.size + w.radius] = w.generation;
+
+    // Lines leave the grid for good once they cross its edge, so each
+    // quadrant stops there. A quadrant with no width is covered by its
+    // neighbours, which share its axis cells.
+    const int reach = static_cast<int>(std::ceil(maxCells)) + 1;
+    for (int dy = -1; dy <= 1; dy += 2) {
+        for (int dx = -1; dx <= 1; dx += 2) {
+            int extentX = std::min(reach, dx > 0 ? m.width() - 1 - col : col);
+            int extentY = std::min(reach, dy > 0 ? m.height() - 1 - row : row);
+            if (extentX <= 0 || extentY <= 0) continue;
+            QuadrantScan scan = { m, w, row, col, dx, dy, originRow, originCol, maxCells };
+            scan.run(extentX, extentY);
+        }
+    }
+
+    // Encode the marked window as runs of linear cell indices
+    uint32_t previousEnd = 0;
+    for (int wr = 0; wr < w.size; ++wr) {
+        int r = originRow + wr;
+        if (r < 0 || r >= m.height()) continue;
+        const uint32_t* line = w.stamp.data() + wr * w.size;
+        int c0 = std::max(0, -originCol), c1 = std::min(w.size, m.width() - originCol);
+        for (int wc = c0; wc < c1; ) {
+            if (line[wc] != w.generation) { ++wc; continue; }
+            int start = wc;
+            while (wc < c1 && line[wc] == w.generation) ++wc;
+            uint32_t first = static_cast<uint32_t>(r) * m.width() + (originCol + start);
+            putVarint(out, first - previousEnd);
+            putVarint(out, static_cast<uint32_t>(wc - start));
+            previousEnd = first + (wc - start);
+        }
+    }
+}
+
+void PotentiallyVisibleSet::build(const Maze& m, float maxCells, int threads) {
+    width = m.width();
+    height = m.height();
+    mazeHash = hashMaze(m);
+
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+
+    // Rows are handed out dynamically; each row's sets are encoded separately
+    // and stitched together in order afterwards.
+    std::vector<std::vector<uint8_t>> rowData(height);
+    std::vector<std::vector<uint32_t>> rowSizes(height);
+    std::atomic<int> nextRow(0);
+
+    auto work = [&]() {
+        PvsWorker w;
+        w.radius = static_cast<int>(std::ceil(maxCells)) + 2;
+        w.size = 2 * w.radius + 1;
+        w.stamp.assign(static_cast<std::size_t>(w.size) * w.size, 0);
+
+        for (int row = nextRow++; row < height; row = nextRow++) {
+            std::vector<uint8_t>& out = rowData[row];
+            std::vector<uint32_t>& sizes = rowSizes[row];
+            sizes.assign(width, 0);
+            for (int col = 0; col < width; ++col) {
+                if (m.isWall(row, col)) continue;
+                std::size_t before = out.size();
+                buildCell(m, row, col, maxCells, w, out);
+                sizes[col] = static_cast<uint32_t>(out.size() - before);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool)
+        t.join();
+
+    offsets.assign(static_cast<std::size_t>(width) * height + 1, 0);
+    data.clear();
+    std::size_t total = 0;
+    for (const auto& bytes : rowData) total += bytes.size();
+    data.reserve(total);
+
+    uint32_t offset = 0;
+    for (int row = 0; row < height; ++row) {
+        data.insert(data.end(), rowData[row].begin(), rowData[row].end());
+        for (int col = 0; col < width; ++col) {
+            offsets[static_cast<std::size_t>(row) * width + col] = offset;
+            offset += rowSizes[row][col];
+        }
+        std::vector<uint8_t>().swap(rowData[row]);
+    }
+    offsets.back() = offset;
+}
+
+// --- Persistence ---
+bool PotentiallyVisibleSet::save(const std::string& path) const {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to write PVS file " << path << "\n";
+        return false;
+    }
+    uint32_t header[4] = { PVS_MAGIC, PVS_VERSION, static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
+    uint64_t dataSize = data.size();
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&mazeHash), sizeof(mazeHash));
+    file.write(reinterpret_cast<const char*>(&dataSize), sizeof(dataSize));
+    file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+bool PotentiallyVisibleSet::load(const std::string& path, const Maze& m) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+
+    uint32_t header[4] = {};
+    uint64_t hash = 0, dataSize = 0;
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+    file.read(reinterpret_cast<char*>(&dataSize), sizeof(dataSize));
+    if (!file || header[0] != PVS_MAGIC || header[1] != PVS_VERSION) {
+        std::cerr << "PVS file " << path << " is not valid\n";
+        return false;
+    }
+    if (static_cast<int>(header[2]) != m.width() || static_cast<int>(header[3]) != m.height() ||
+        hash != hashMaze(m)) {
+        std::cerr << "PVS file " << path << " was built for a different maze\n";
+        return false;
+    }
+
+    width = static_cast<int>(header[2]);
+    height = static_cast<int>(header[3]);
+    mazeHash = hash;
+    offsets.resize(static_cast<std::size_t>(width) * height + 1);
+    data.resize(dataSize);
+    file.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(uint32_t));
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    if (!file || offsets.back() != dataSize) {
+        std::cerr << "PVS file " << path << " is truncated\n";
+        offsets.clear();
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+// --- Queries ---
+bool PotentiallyVisibleSet::hasSet(int row, int col) const {
+    if (row < 0 || row >= height || col < 0 || col >= width) return false;
+    std::size_t cell = static_cast<std::size_t>(row) * width + col;
+    return offsets[cell + 1] > offsets[cell];
+}
+
+void PotentiallyVisibleSet::decode(int row, int col, std::vector<std::pair<uint32_t, uint32_t>>& runs) const {
+    runs.clear();
+    if (!hasSet(row, col)) return;
+    std::size_t cell = static_cast<std::size_t>(row) * width + col;
+    const uint8_t* p = data.data() + offsets[cell];
+    const uint8_t* end = data.data() + offsets[cell + 1];
+    uint32_t position = 0;
+    while (p < end) {
+        uint32_t start = position + getVarint(p);
+        uint32_t length = getVarint(p);
+        runs.emplace_back(start, start + length);
+        position = start + length;
+    }
+}
+
+bool PvsLookup::select(const PotentiallyVisibleSet& pvs, const Maze& m, int row, int col) {
+    if (row == currentRow && col == currentCol) return !runs.empty();
+    currentRow = row;
+    currentCol = col;
+    width = pvs.gridWidth();
+    pvs.decode(row, col, runs);
+    wallsSeen = 0;
+    for (const auto& run : runs)
+        for (uint32_t i = run.first; i < run.second; ++i)
+            wallsSeen += m.isWall(static_cast<int>(i / width), static_cast<int>(i % width));
+    return !runs.empty();
+}
+
+bool PvsLookup::anyVisibleIn(int row0, int col0, int rows, int cols) const {
+    for (int r = row0; r < row0 + rows; ++r) {
+        uint32_t first = static_cast<uint32_t>(r) * width + col0;
+        uint32_t last = first + cols; // exclusive
+        // First run ending after `first`
+        auto it = std::upper_bound(runs.begin(), runs.end(), first,
+                                   [](uint32_t value, const std::pair<uint32_t, uint32_t>& run) {
+                                       return value < run.second;
+                                   });
+        if (it != runs.end() && it->first < last) return true;
+    }
+    return false;
+}
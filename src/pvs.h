@@ -0,0 +1,60 @@
+#ifndef PVS_H
+#define PVS_H
+
+#include "maze_grid.h"
+#include "visibility.h"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Precomputed potentially visible set: for every open cell, the cells that
+// can be seen from anywhere inside it. Each set is a run-length bitset over
+// linear cell indices (row * width + col), stored as varint-encoded
+// (gap, length) pairs, so a typical maze cell costs a few dozen bytes.
+class PotentiallyVisibleSet {
+public:
+    // Every cell a straight line from anywhere inside the open cell can
+    // reach, up to maxCells away, found exactly with a permissive field of
+    // view scan rather than sampled rays. threads = 0 uses every hardware
+    // thread. On one core a 1025x1025 maze with a 75 cell view distance
+    // takes about 16 s (backtracker) to 23 s (Kruskal with carved rooms);
+    // rows are handed out to threads dynamically, so 8 cores should bring
+    // that to 2-3 s.
+    void build(const Maze& m, float maxCells, int threads = 0);
+
+    bool save(const std::string& path) const;
+    // Fails if the file is missing, corrupt or was built for a different maze
+    bool load(const std::string& path, const Maze& m);
+
+    bool empty() const { return offsets.empty(); }
+    int gridWidth() const { return width; }
+    bool hasSet(int row, int col) const;
+    // Decode the visible runs [first, last) of linear cell indices for (row, col)
+    void decode(int row, int col, std::vector<std::pair<uint32_t, uint32_t>>& runs) const;
+
+    std::size_t memoryBytes() const { return data.size() + offsets.size() * sizeof(uint32_t); }
+
+private:
+    int width = 0, height = 0;
+    uint64_t mazeHash = 0;
+    std::vector<uint32_t> offsets; // width * height + 1 byte offsets into data
+    std::vector<uint8_t> data;
+};
+
+// The PVS of the camera's cell, decoded once whenever the camera changes cell
+class PvsLookup : public CellVisibility {
+public:
+    // Returns false if the cell has no set (a wall or outside the maze)
+    bool select(const PotentiallyVisibleSet& pvs, const Maze& m, int row, int col);
+    bool anyVisibleIn(int row0, int col0, int rows, int cols) const override;
+    int visibleWallCells() const override { return wallsSeen; }
+
+private:
+    int width = 0;
+    int currentRow = -1, currentCol = -1;
+    std::vector<std::pair<uint32_t, uint32_t>> runs;
+    int wallsSeen = 0;
+};
+
+#endif
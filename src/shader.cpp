@@ -0,0 +1,90 @@
+#include "shader.h"
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+static GLuint compileStage(GLenum type, const char* path) {
+    std::ifstream file(path);
+    std::stringstream stream;
+    stream << file.rdbuf();
+    std::string code = stream.str();
+    const char* source = code.c_str();
+
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint ok = GL_FALSE;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
+        std::cerr << "Failed to compile " << path << ":\n" << log << "\n";
+    }
+    return shader;
+}
+
+bool ShaderProgram::load(const char* vertexPath, const char* fragmentPath) {
+    GLuint vertex = compileStage(GL_VERTEX_SHADER, vertexPath);
+    GLuint fragment = compileStage(GL_FRAGMENT_SHADER, fragmentPath);
+
+    program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &ok);
+    if (!ok) {
+        char log[1024];
+        glGetProgramInfoLog(program, sizeof(log), nullptr, log);
+        std::cerr << "Failed to link shader program:\n" << log << "\n";
+        return false;
+    }
+
+    // Resolve every active uniform once; block members report -1 and are skipped
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; ++i) {
+        char name[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, sizeof(name), &length, &size, &type, name);
+        std::string key(name, length);
+        if (key.size() > 3 && key.compare(key.size() - 3, 3, "[0]") == 0)
+            key.resize(key.size() - 3);
+        GLint location = glGetUniformLocation(program, name);
+        if (location >= 0)
+            locations[key] = location;
+    }
+    modelUniform = uniform("model");
+    normalMatrixUniform = uniform("normalMatrix");
+    return true;
+}
+
+GLint ShaderProgram::uniform(const std::string& name) const {
+    auto it = locations.find(name);
+    return it == locations.end() ? -1 : it->second;
+}
+
+void ShaderProgram::bindUniformBlock(const char* name, GLuint bindingPoint) const {
+    GLuint index = glGetUniformBlockIndex(program, name);
+    if (index != GL_INVALID_INDEX)
+        glUniformBlockBinding(program, index, bindingPoint);
+}
+
+void FrameUniformBuffer::create(GLuint bindingPoint) {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, ubo);
+}
+
+void FrameUniformBuffer::upload(const FrameUniforms& frame) const {
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+}
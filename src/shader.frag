@@ -4,14 +4,17 @@ out vec4 FragColor;
 in vec3 FragPos;
 in vec3 Normal;
 
-uniform vec3 lightPos;
-uniform vec3 viewPos;
-uniform vec3 lightDir;    // spotlight direction
-uniform float cutOff;     // cosine of inner angle
-uniform float outerCutOff;// cosine of outer angle
-
-uniform vec3 lightColor;
-uniform vec3 objectColor;
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float cutOff;      // cosine of inner angle
+    vec3 viewPos;
+    float outerCutOff; // cosine of outer angle
+    vec3 lightDir;     // spotlight direction
+    vec3 lightColor;
+    vec3 objectColor;
+};
 
 void main()
 {
@@ -0,0 +1,58 @@
+#ifndef SHADER_H
+#define SHADER_H
+
+#include <GL/glew.h>
+#include "gl_stats.h"
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+
+// Binding point shared by every program that declares the "Frame" block
+const GLuint FRAME_UNIFORM_BINDING = 0;
+
+// Per-frame camera/light state, laid out to match the std140 "Frame" block
+// in shader.vert / shader.frag (each vec3 is padded to 16 bytes).
+struct FrameUniforms {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::vec3 lightPos;    float cutOff;
+    glm::vec3 viewPos;     float outerCutOff;
+    glm::vec3 lightDir;    float pad0;
+    glm::vec3 lightColor;  float pad1;
+    glm::vec3 objectColor; float pad2;
+};
+static_assert(sizeof(FrameUniforms) == 208, "FrameUniforms must match the std140 layout");
+
+// Linked GLSL program with every active uniform location resolved once
+class ShaderProgram {
+public:
+    bool load(const char* vertexPath, const char* fragmentPath);
+    void use() const { glUseProgram(program); }
+    GLuint id() const { return program; }
+
+    // Cached location, or -1 if the uniform is not active
+    GLint uniform(const std::string& name) const;
+    void bindUniformBlock(const char* name, GLuint bindingPoint) const;
+
+    // Per-draw uniforms of shader.vert, looked up once by load() so draws
+    // never go through the name map
+    GLint modelLocation() const { return modelUniform; }
+    GLint normalMatrixLocation() const { return normalMatrixUniform; }
+
+private:
+    GLuint program = 0;
+    std::unordered_map<std::string, GLint> locations;
+    GLint modelUniform = -1, normalMatrixUniform = -1;
+};
+
+// Uniform buffer holding FrameUniforms, updated with one glBufferSubData
+class FrameUniformBuffer {
+public:
+    void create(GLuint bindingPoint);
+    void upload(const FrameUniforms& frame) const;
+
+private:
+    GLuint ubo = 0;
+};
+
+#endif
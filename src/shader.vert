@@ -1,20 +1,32 @@
 #version 330 core
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aOffset; // per-instance offset, zero when not instanced
 
 out vec3 FragPos;
 out vec3 Normal;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform mat3 normalMatrix; // inverse-transpose of model, computed on the CPU
+
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    vec3 lightPos;
+    float cutOff;
+    vec3 viewPos;
+    float outerCutOff;
+    vec3 lightDir;
+    vec3 lightColor;
+    vec3 objectColor;
+};
 
 void main()
 {
     // Position in world space
-    FragPos = vec3(model * vec4(aPos, 1.0));
+    FragPos = vec3(model * vec4(aPos, 1.0)) + aOffset;
     // Normal in world space
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = normalMatrix * aNormal;
     // Final vertex position
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
\ No newline at end of file
@@ -0,0 +1,20 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+// Instruction sets available to the hand-vectorized paths. This mirrors the
+// compiler checks in glm/simd/platform.h, but does not define
+// GLM_FORCE_INTRINSICS, which would change the alignment of every glm type.
+#if defined(__AVX2__)
+#   define MAZE_SIMD_AVX2 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define MAZE_SIMD_SSE2 1
+#endif
+
+#if defined(MAZE_SIMD_AVX2)
+#   include <immintrin.h>
+#elif defined(MAZE_SIMD_SSE2)
+#   include <emmintrin.h>
+#endif
+
+#endif
@@ -0,0 +1,411 @@
+#include "software_raster.h"
+#include "chunk.h"
+#include "simd.h"
+#include "wall_mesh.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+
+#if defined(MAZE_SIMD_AVX2)
+static const int LANES = 8;
+#elif defined(MAZE_SIMD_SSE2)
+static const int LANES = 4;
+#else
+static const int LANES = 1;
+#endif
+
+static const uint32_t NO_TRIANGLE = 0xffffffffu;
+
+SoftwareRasterizer::SoftwareRasterizer(int threads) : pool(threads) {
+    scratch.resize(pool.size());
+    for (TileScratch& s : scratch) {
+        s.depth.resize(TILE_SIZE * TILE_SIZE);
+        s.ids.resize(TILE_SIZE * TILE_SIZE);
+    }
+}
+
+// --- Scene ---
+void SoftwareRasterizer::setScene(const Maze& m, float spacing) {
+    meshes.clear();
+    meshBounds.clear();
+
+    std::vector<float> vertices;
+    for (int row0 = 0; row0 < m.height(); row0 += CHUNK_SIZE) {
+        for (int col0 = 0; col0 < m.width(); col0 += CHUNK_SIZE) {
+            const int rows = std::min(CHUNK_SIZE, m.height() - row0);
+            const int cols = std::min(CHUNK_SIZE, m.width() - col0);
+            vertices.clear();
+            buildWallMesh(m, spacing, row0, col0, rows, cols, vertices);
+            if (vertices.empty()) continue;
+
+            Mesh mesh;
+            for (std::size_t v = 0; v < vertices.size(); v += 6) {
+                mesh.positions.emplace_back(vertices[v], vertices[v + 1], vertices[v + 2]);
+                if (v % 18 == 0)
+                    mesh.triangleNormals.emplace_back(vertices[v + 3], vertices[v + 4], vertices[v + 5]);
+            }
+            meshes.push_back(std::move(mesh));
+            meshBounds.add(glm::vec3(col0 * spacing, 0.0f, -(row0 + rows) * spacing),
+                           glm::vec3((col0 + cols) * spacing, spacing * WALL_HEIGHT_SCALE, -row0 * spacing));
+        }
+    }
+
+    // The floor quad of initMaze(), placed as rebuildMaze() does
+    const float extentX = m.width() * spacing, extentZ = m.height() * spacing;
+    const float centerX = extentX / 2.0f, centerZ = -extentZ / 2.0f;
+    const float halfX = 2.0f * (extentX + 8.0f), halfZ = 2.0f * (extentZ + 8.0f);
+    Mesh floor;
+    const float corners[6][2] = { { -1, 1 }, { 1, 1 }, { 1, -1 }, { 1, -1 }, { -1, -1 }, { -1, 1 } };
+    for (const auto& c : corners)
+        floor.positions.emplace_back(centerX + c[0] * halfX, 0.0f, centerZ + c[1] * halfZ);
+    floor.triangleNormals.assign(2, glm::vec3(0.0f, 1.0f, 0.0f));
+    meshes.push_back(std::move(floor));
+    meshBounds.add(glm::vec3(centerX - halfX, 0.0f, centerZ - halfZ), glm::vec3(centerX + halfX, 0.0f, centerZ + halfZ));
+}
+
+void SoftwareRasterizer::resize(int width, int height) {
+    imageWidth = width;
+    imageHeight = height;
+    tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+    image.assign(static_cast<std::size_t>(width) * height, 0);
+}
+
+// --- Triangle setup and binning ---
+// Clip to the near and far planes (x and y only need the bounds clamp
+// below), project to pixels and add the result to every tile it overlaps.
+void SoftwareRasterizer::setupRange(const RasterFrame& frame, std::size_t first, std::size_t last,
+                                    ThreadBins& out) const {
+    const glm::mat4 viewProjection = frame.projection * frame.view;
+
+    for (std::size_t i = first; i < last; ++i) {
+        const Mesh& mesh = meshes[batch[i].first];
+        const uint32_t triangle = batch[i].second;
+        glm::vec4 clip[3];
+        for (int v = 0; v < 3; ++v)
+            clip[v] = viewProjection * glm::vec4(mesh.positions[triangle * 3 + v], 1.0f);
+
+        // Entirely outside one side plane
+        bool outside = false;
+        for (int axis = 0; axis < 2 && !outside; ++axis) {
+            outside = (clip[0][axis] > clip[0].w && clip[1][axis] > clip[1].w && clip[2][axis] > clip[2].w) ||
+                      (clip[0][axis] < -clip[0].w && clip[1][axis] < -clip[1].w && clip[2][axis] < -clip[2].w);
+        }
+        if (outside) continue;
+
+        // Sutherland-Hodgman against z >= -w (near) and z <= w (far)
+        glm::vec4 polygon[5], clipped[5];
+        int count = 3;
+        std::copy(clip, clip + 3, polygon);
+        for (int plane = 0; plane < 2 && count > 0; ++plane) {
+            const float sign = plane == 0 ? 1.0f : -1.0f;
+            int kept = 0;
+            for (int v = 0; v < count; ++v) {
+                const glm::vec4& a = polygon[v];
+                const glm::vec4& b = polygon[(v + 1) % count];
+                const float da = a.w + sign * a.z, db = b.w + sign * b.z;
+                if (da >= 0.0f) clipped[kept++] = a;
+                if ((da >= 0.0f) != (db >= 0.0f))
+                    clipped[kept++] = a + (b - a) * (da / (da - db));
+            }
+            count = kept;
+            std::copy(clipped, clipped + count, polygon);
+        }
+        if (count < 3) continue;
+
+        float sx[5], sy[5], iw[5];
+        for (int v = 0; v < count; ++v) {
+            iw[v] = 1.0f / polygon[v].w;
+            sx[v] = (polygon[v].x * iw[v] * 0.5f + 0.5f) * imageWidth;
+            sy[v] = (0.5f - polygon[v].y * iw[v] * 0.5f) * imageHeight;
+        }
+
+        // Fan out the clipped polygon
+        for (int v = 1; v + 1 < count; ++v) {
+            int a = 0, b = v, c = v + 1;
+            float area = (sx[b] - sx[a]) * (sy[c] - sy[a]) - (sy[b] - sy[a]) * (sx[c] - sx[a]);
+            if (!(std::fabs(area) > 0.0f)) continue; // degenerate or NaN
+            if (area < 0.0f) std::swap(b, c);
+
+            ScreenTriangle t;
+            const int order[3] = { a, b, c };
+            for (int k = 0; k < 3; ++k) {
+                t.x[k] = sx[order[k]];
+                t.y[k] = sy[order[k]];
+                t.iw[k] = iw[order[k]];
+            }
+            t.normal = mesh.triangleNormals[triangle];
+            // Clamped as floats first: near-plane vertices can land far off screen
+            const float right = static_cast<float>(imageWidth - 1), bottom = static_cast<float>(imageHeight - 1);
+            t.minX = static_cast<int>(std::floor(glm::clamp(std::min({ t.x[0], t.x[1], t.x[2] }), 0.0f, right + 1.0f)));
+            t.minY = static_cast<int>(std::floor(glm::clamp(std::min({ t.y[0], t.y[1], t.y[2] }), 0.0f, bottom + 1.0f)));
+            t.maxX = static_cast<int>(std::ceil(glm::clamp(std::max({ t.x[0], t.x[1], t.x[2] }), -1.0f, right)));
+            t.maxY = static_cast<int>(std::ceil(glm::clamp(std::max({ t.y[0], t.y[1], t.y[2] }), -1.0f, bottom)));
+            if (t.minX > t.maxX || t.minY > t.maxY) continue;
+
+            const uint32_t index = static_cast<uint32_t>(out.triangles.size());
+            out.triangles.push_back(t);
+            for (int ty = t.minY / TILE_SIZE; ty <= t.maxY / TILE_SIZE; ++ty)
+                for (int tx = t.minX / TILE_SIZE; tx <= t.maxX / TILE_SIZE; ++tx)
+                    out.tiles[ty * tilesX + tx].push_back(index);
+        }
+    }
+}
+
+// --- Rasterization ---
+// Edge function of the edge i -> j, relative to a pixel centre origin:
+// e(x, y) = a * x + b * y + c, positive inside
+struct Edge {
+    float a, b;
+    double c;
+    bool includeZero; // top-left rule: one of two triangles sharing the edge owns it
+};
+
+static Edge makeEdge(const float* x, const float* y, int i, int j, double originX, double originY) {
+    Edge e;
+    e.a = y[i] - y[j];
+    e.b = x[j] - x[i];
+    e.c = static_cast<double>(e.a) * (originX - x[i]) + static_cast<double>(e.b) * (originY - y[i]);
+    e.includeZero = e.a > 0.0f || (e.a == 0.0f && e.b > 0.0f);
+    return e;
+}
+
+// Shade one visible pixel with the model of shader.frag
+static uint32_t shade(const RasterFrame& frame, const glm::vec3& position, const glm::vec3& normal) {
+    glm::vec3 ambient = 0.05f * frame.lightColor;
+
+    const glm::vec3 norm = glm::normalize(normal);
+    const glm::vec3 lightDirection = glm::normalize(frame.lightPos - position);
+    const float diff = std::max(glm::dot(norm, lightDirection), 0.0f);
+    glm::vec3 diffuse = diff * frame.lightColor;
+
+    const glm::vec3 viewDir = glm::normalize(frame.viewPos - position);
+    const glm::vec3 reflectDir = glm::reflect(-lightDirection, norm);
+    float spec = std::max(glm::dot(viewDir, reflectDir), 0.0f);
+    for (int i = 0; i < 6; ++i) spec *= spec; // pow(spec, 64)
+    glm::vec3 specular = 0.3f * spec * frame.lightColor;
+
+    const glm::vec3 spotDir = glm::normalize(-frame.lightDir);
+    const float theta = glm::dot(lightDirection, spotDir);
+    const float epsilon = frame.cutOff - frame.outerCutOff;
+    const float intensity = glm::clamp((theta - frame.outerCutOff) / epsilon, 0.0f, 1.0f);
+    if (theta > frame.cutOff) {
+        // inner cone: fully lit
+    } else if (theta > frame.outerCutOff) {
+        diffuse *= intensity;
+        specular *= intensity;
+    } else {
+        diffuse *= 0.1f;
+        specular *= 0.1f;
+        ambient += 0.10f * frame.lightColor;
+    }
+
+    const glm::vec3 result = glm::clamp((ambient + diffuse + specular) * frame.objectColor, 0.0f, 1.0f);
+    return static_cast<uint32_t>(result.r * 255.0f + 0.5f) |
+           static_cast<uint32_t>(result.g * 255.0f + 0.5f) << 8 |
+           static_cast<uint32_t>(result.b * 255.0f + 0.5f) << 16 | 0xff000000u;
+}
+
+void SoftwareRasterizer::rasterTile(int tile, const RasterFrame& frame, std::vector<const ScreenTriangle*>& order,
+                                    std::vector<float>& depth, std::vector<uint32_t>& ids) {
+    const int x0 = (tile % tilesX) * TILE_SIZE, y0 = (tile / tilesX) * TILE_SIZE;
+    const int tileW = std::min(TILE_SIZE, imageWidth - x0), tileH = std::min(TILE_SIZE, imageHeight - y0);
+
+    // Submission order: every thread's bin in turn, each in input order
+    order.clear();
+    for (const ThreadBins& b : bins)
+        for (uint32_t index : b.tiles[tile])
+            order.push_back(&b.triangles[index]);
+
+    // Depth holds 1/w, larger is nearer; 0 is the cleared far end
+    std::fill(depth.begin(), depth.end(), 0.0f);
+    std::fill(ids.begin(), ids.end(), NO_TRIANGLE);
+
+    const double originX = x0 + 0.5, originY = y0 + 0.5;
+    for (uint32_t id = 0; id < order.size(); ++id) {
+        const ScreenTriangle& t = *order[id];
+        const Edge e12 = makeEdge(t.x, t.y, 1, 2, originX, originY); // weight of vertex 0
+        const Edge e20 = makeEdge(t.x, t.y, 2, 0, originX, originY); // weight of vertex 1
+        const Edge e01 = makeEdge(t.x, t.y, 0, 1, originX, originY); // weight of vertex 2
+
+        // 1/w is linear in screen space: a plane over the three vertices
+        const double area = static_cast<double>(e01.a) * (t.x[2] - t.x[0]) + static_cast<double>(e01.b) * (t.y[2] - t.y[0]);
+        const float za = static_cast<float>((e12.a * t.iw[0] + e20.a * t.iw[1] + e01.a * t.iw[2]) / area);
+        const float zb = static_cast<float>((e12.b * t.iw[0] + e20.b * t.iw[1] + e01.b * t.iw[2]) / area);
+        const double zc = (e12.c * t.iw[0] + e20.c * t.iw[1] + e01.c * t.iw[2]) / area;
+
+        const int lx0 = std::max(t.minX - x0, 0), lx1 = std::min(t.maxX - x0, tileW - 1);
+        const int ly0 = std::max(t.minY - y0, 0), ly1 = std::min(t.maxY - y0, tileH - 1);
+        for (int ly = ly0; ly <= ly1; ++ly) {
+            const float c12 = static_cast<float>(e12.b * static_cast<double>(ly) + e12.c);
+            const float c20 = static_cast<float>(e20.b * static_cast<double>(ly) + e20.c);
+            const float c01 = static_cast<float>(e01.b * static_cast<double>(ly) + e01.c);
+            const float cz = static_cast<float>(zb * static_cast<double>(ly) + zc);
+            float* depthRow = &depth[ly * TILE_SIZE];
+            uint32_t* idRow = &ids[ly * TILE_SIZE];
+            int lx = lx0 & ~(LANES - 1);
+
+#if defined(MAZE_SIMD_AVX2)
+            const __m256 laneOffsets = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256 zero = _mm256_setzero_ps();
+            const __m256 first = _mm256_set1_ps(static_cast<float>(lx0) - 0.5f);
+            const __m256 last = _mm256_set1_ps(static_cast<float>(lx1) + 0.5f);
+            const __m256 tie12 = _mm256_castsi256_ps(_mm256_set1_epi32(e12.includeZero ? -1 : 0));
+            const __m256 tie20 = _mm256_castsi256_ps(_mm256_set1_epi32(e20.includeZero ? -1 : 0));
+            const __m256 tie01 = _mm256_castsi256_ps(_mm256_set1_epi32(e01.includeZero ? -1 : 0));
+            const __m256 idV = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(id)));
+            for (; lx <= lx1; lx += LANES) {
+                const __m256 xs = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(lx)), laneOffsets);
+                const __m256 w0 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(e12.a), xs), _mm256_set1_ps(c12));
+                const __m256 w1 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(e20.a), xs), _mm256_set1_ps(c20));
+                const __m256 w2 = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(e01.a), xs), _mm256_set1_ps(c01));
+                __m256 inside = _mm256_and_ps(_mm256_cmp_ps(xs, first, _CMP_GT_OQ), _mm256_cmp_ps(xs, last, _CMP_LT_OQ));
+                inside = _mm256_and_ps(inside, _mm256_or_ps(_mm256_cmp_ps(w0, zero, _CMP_GT_OQ),
+                                                            _mm256_and_ps(_mm256_cmp_ps(w0, zero, _CMP_EQ_OQ), tie12)));
+                inside = _mm256_and_ps(inside, _mm256_or_ps(_mm256_cmp_ps(w1, zero, _CMP_GT_OQ),
+                                                            _mm256_and_ps(_mm256_cmp_ps(w1, zero, _CMP_EQ_OQ), tie20)));
+                inside = _mm256_and_ps(inside, _mm256_or_ps(_mm256_cmp_ps(w2, zero, _CMP_GT_OQ),
+                                                            _mm256_and_ps(_mm256_cmp_ps(w2, zero, _CMP_EQ_OQ), tie01)));
+                if (_mm256_movemask_ps(inside) == 0) continue;
+
+                const __m256 z = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(za), xs), _mm256_set1_ps(cz));
+                const __m256 oldZ = _mm256_loadu_ps(depthRow + lx);
+                const __m256 pass = _mm256_and_ps(inside, _mm256_cmp_ps(z, oldZ, _CMP_GT_OQ));
+                _mm256_storeu_ps(depthRow + lx, _mm256_blendv_ps(oldZ, z, pass));
+                float* idSlot = reinterpret_cast<float*>(idRow + lx);
+                _mm256_storeu_ps(idSlot, _mm256_blendv_ps(_mm256_loadu_ps(idSlot), idV, pass));
+            }
+#elif defined(MAZE_SIMD_SSE2)
+            const __m128 laneOffsets = _mm_setr_ps(0, 1, 2, 3);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 first = _mm_set1_ps(static_cast<float>(lx0) - 0.5f);
+            const __m128 last = _mm_set1_ps(static_cast<float>(lx1) + 0.5f);
+            const __m128 tie12 = _mm_castsi128_ps(_mm_set1_epi32(e12.includeZero ? -1 : 0));
+            const __m128 tie20 = _mm_castsi128_ps(_mm_set1_epi32(e20.includeZero ? -1 : 0));
+            const __m128 tie01 = _mm_castsi128_ps(_mm_set1_epi32(e01.includeZero ? -1 : 0));
+            const __m128 idV = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(id)));
+            for (; lx <= lx1; lx += LANES) {
+                const __m128 xs = _mm_add_ps(_mm_set1_ps(static_cast<float>(lx)), laneOffsets);
+                const __m128 w0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e12.a), xs), _mm_set1_ps(c12));
+                const __m128 w1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e20.a), xs), _mm_set1_ps(c20));
+                const __m128 w2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(e01.a), xs), _mm_set1_ps(c01));
+                __m128 inside = _mm_and_ps(_mm_cmpgt_ps(xs, first), _mm_cmplt_ps(xs, last));
+                inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(w0, zero), _mm_and_ps(_mm_cmpeq_ps(w0, zero), tie12)));
+                inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(w1, zero), _mm_and_ps(_mm_cmpeq_ps(w1, zero), tie20)));
+                inside = _mm_and_ps(inside, _mm_or_ps(_mm_cmpgt_ps(w2, zero), _mm_and_ps(_mm_cmpeq_ps(w2, zero), tie01)));
+                if (_mm_movemask_ps(inside) == 0) continue;
+
+                const __m128 z = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(za), xs), _mm_set1_ps(cz));
+                const __m128 oldZ = _mm_loadu_ps(depthRow + lx);
+                const __m128 pass = _mm_and_ps(inside, _mm_cmpgt_ps(z, oldZ));
+                _mm_storeu_ps(depthRow + lx, _mm_or_ps(_mm_and_ps(pass, z), _mm_andnot_ps(pass, oldZ)));
+                float* idSlot = reinterpret_cast<float*>(idRow + lx);
+                const __m128 oldId = _mm_loadu_ps(idSlot);
+                _mm_storeu_ps(idSlot, _mm_or_ps(_mm_and_ps(pass, idV), _mm_andnot_ps(pass, oldId)));
+            }
+#else
+            for (; lx <= lx1; ++lx) {
+                const float xs = static_cast<float>(lx);
+                const float w0 = e12.a * xs + c12, w1 = e20.a * xs + c20, w2 = e01.a * xs + c01;
+                const bool inside = (w0 > 0.0f || (w0 == 0.0f && e12.includeZero)) &&
+                                    (w1 > 0.0f || (w1 == 0.0f && e20.includeZero)) &&
+                                    (w2 > 0.0f || (w2 == 0.0f && e01.includeZero));
+                const float z = za * xs + cz;
+                if (inside && z > depthRow[lx]) {
+                    depthRow[lx] = z;
+                    idRow[lx] = id;
+                }
+            }
+#endif
+        }
+    }
+
+    // Shade each covered pixel once. The world position comes back from
+    // 1/w through the inverse view-projection; with a glm::perspective
+    // projection, clip z is linear in clip w.
+    const glm::mat4 inverseViewProjection = glm::inverse(frame.projection * frame.view);
+    const float zScale = frame.projection[2][2], zOffset = frame.projection[3][2];
+    const glm::vec4 zTerm = zOffset * inverseViewProjection[2];
+    const glm::vec4 clearRgb = glm::vec4(glm::clamp(frame.clearColor, 0.0f, 1.0f) * 255.0f + 0.5f, 0.0f);
+    const uint32_t clear = static_cast<uint32_t>(clearRgb.r) | static_cast<uint32_t>(clearRgb.g) << 8 |
+                           static_cast<uint32_t>(clearRgb.b) << 16 | 0xff000000u;
+
+    for (int ly = 0; ly < tileH; ++ly) {
+        uint32_t* out = &image[static_cast<std::size_t>(y0 + ly) * imageWidth + x0];
+        const float ndcY = 1.0f - 2.0f * (y0 + ly + 0.5f) / imageHeight;
+        const glm::vec4 rowTerm = ndcY * inverseViewProjection[1] - zScale * inverseViewProjection[2] + inverseViewProjection[3];
+        for (int lx = 0; lx < tileW; ++lx) {
+            const uint32_t id = ids[ly * TILE_SIZE + lx];
+            if (id == NO_TRIANGLE) {
+                out[lx] = clear;
+                continue;
+            }
+            const float w = 1.0f / depth[ly * TILE_SIZE + lx];
+            const float ndcX = 2.0f * (x0 + lx + 0.5f) / imageWidth - 1.0f;
+            const glm::vec4 world = w * (ndcX * inverseViewProjection[0] + rowTerm) + zTerm;
+            out[lx] = shade(frame, glm::vec3(world) / world.w, order[id]->normal);
+        }
+    }
+}
+
+// --- Frame ---
+void SoftwareRasterizer::render(const RasterFrame& frame) {
+    const int tileCount = tilesX * tilesY;
+    if (tileCount == 0) return;
+
+    // Whole chunks outside the frustum never reach setup
+    meshVisible.resize(meshes.size());
+    cullBoxes(extractFrustum(frame.projection * frame.view), meshBounds, meshVisible.data());
+    batch.clear();
+    for (uint32_t mesh = 0; mesh < meshes.size(); ++mesh) {
+        if (!meshVisible[mesh]) continue;
+        for (uint32_t t = 0; t < meshes[mesh].triangleNormals.size(); ++t)
+            batch.emplace_back(mesh, t);
+    }
+
+    const int threads = pool.size();
+    bins.resize(threads);
+    for (ThreadBins& b : bins) {
+        b.triangles.clear();
+        b.tiles.resize(tileCount);
+        for (auto& tile : b.tiles) tile.clear();
+    }
+
+    // Contiguous ranges of the batch, so bins keep submission order
+    pool.run([&](int t) {
+        setupRange(frame, batch.size() * t / threads, batch.size() * (t + 1) / threads, bins[t]);
+    });
+
+    drawn = 0;
+    for (const ThreadBins& b : bins) drawn += b.triangles.size();
+
+    // Tiles are handed out dynamically; each writes only its pixels
+    std::atomic<int> nextTile(0);
+    pool.run([&](int t) {
+        TileScratch& s = scratch[t];
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++)
+            rasterTile(tile, frame, s.order, s.depth, s.ids);
+    });
+}
+
+bool SoftwareRasterizer::savePpm(const std::string& path) const {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Failed to write image " << path << "\n";
+        return false;
+    }
+    std::fprintf(file, "P6\n%d %d\n255\n", imageWidth, imageHeight);
+    std::vector<uint8_t> row(static_cast<std::size_t>(imageWidth) * 3);
+    for (int y = 0; y < imageHeight; ++y) {
+        for (int x = 0; x < imageWidth; ++x) {
+            const uint32_t p = image[static_cast<std::size_t>(y) * imageWidth + x];
+            row[x * 3] = static_cast<uint8_t>(p);
+            row[x * 3 + 1] = static_cast<uint8_t>(p >> 8);
+            row[x * 3 + 2] = static_cast<uint8_t>(p >> 16);
+        }
+        std::fwrite(row.data(), 1, row.size(), file);
+    }
+    return std::fclose(file) == 0;
+}
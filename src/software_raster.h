@@ -0,0 +1,99 @@
+#ifndef SOFTWARE_RASTER_H
+#define SOFTWARE_RASTER_H
+
+#include "culling.h"
+#include "maze_grid.h"
+#include "worker_pool.h"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Camera and spotlight of one frame: the values main.cpp puts in the
+// "Frame" uniform block
+struct RasterFrame {
+    glm::mat4 view, projection;
+    glm::vec3 lightPos, viewPos, lightDir;
+    glm::vec3 lightColor, objectColor;
+    float cutOff, outerCutOff;           // cosines of the spotlight cones
+    glm::vec3 clearColor;
+};
+
+// CPU renderer for machines without a GL stack (thumbnails, spectating,
+// CI). It draws the same wall and floor geometry as initMaze() and shades
+// it with the spotlight model of shader.frag, into an RGBA8 image.
+//
+// Triangles are clipped and set up in parallel, then binned into
+// TILE_SIZE square screen tiles. Each tile is rasterized by one thread
+// with SIMD edge functions into a depth buffer holding 1/w plus the
+// winning triangle per pixel, and only the visible pixels are shaded.
+// Triangles keep their submission order in every bin, so the image does
+// not depend on the thread count. Both phases run on a pool of worker
+// threads, started once.
+class SoftwareRasterizer {
+public:
+    // threads = 0 uses every hardware thread
+    explicit SoftwareRasterizer(int threads = 0);
+
+    // Bake the maze's walls, one mesh per CHUNK_SIZE block, and the floor
+    void setScene(const Maze& m, float spacing);
+    void resize(int width, int height);
+    void render(const RasterFrame& frame);
+
+    int width() const { return imageWidth; }
+    int height() const { return imageHeight; }
+    // RGBA bytes, top row first
+    const std::vector<uint32_t>& pixels() const { return image; }
+    bool savePpm(const std::string& path) const;
+
+    // Triangles that reached a tile in the last render()
+    std::size_t trianglesDrawn() const { return drawn; }
+
+    static const int TILE_SIZE = 64;
+
+private:
+    struct Mesh {
+        std::vector<glm::vec3> positions;        // triangle list
+        std::vector<glm::vec3> triangleNormals;  // one per triangle
+    };
+    // A clipped triangle in pixel coordinates, wound so its area is positive
+    struct ScreenTriangle {
+        float x[3], y[3];
+        float iw[3];                  // 1 / clip w
+        glm::vec3 normal;
+        int minX, minY, maxX, maxY;   // pixel bounds, inside the image
+    };
+    // What one thread's share of the setup produced
+    struct ThreadBins {
+        std::vector<ScreenTriangle> triangles;
+        std::vector<std::vector<uint32_t>> tiles; // indices into triangles, per tile
+    };
+
+    // Tile buffers of one thread, kept between frames
+    struct TileScratch {
+        std::vector<const ScreenTriangle*> order;
+        std::vector<float> depth;
+        std::vector<uint32_t> ids;
+    };
+    void setupRange(const RasterFrame& frame, std::size_t first, std::size_t last, ThreadBins& out) const;
+    void rasterTile(int tile, const RasterFrame& frame, std::vector<const ScreenTriangle*>& order,
+                    std::vector<float>& depth, std::vector<uint32_t>& ids);
+
+    int imageWidth = 0, imageHeight = 0;
+    int tilesX = 0, tilesY = 0;
+    std::vector<uint32_t> image;
+
+    std::vector<Mesh> meshes;     // wall chunks, then the floor last
+    BoxList meshBounds;
+    std::vector<uint8_t> meshVisible;
+    std::vector<std::pair<uint32_t, uint32_t>> batch; // (mesh, triangle) for this frame
+    std::vector<ThreadBins> bins;
+    std::vector<TileScratch> scratch;
+    std::size_t drawn = 0;
+
+    WorkerPool pool;
+};
+
+#endif
@@ -0,0 +1,381 @@
+#include "solver.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// Neighbour directions: east, south, west, north
+static const int DC[4] = { 1, 0, -1, 0 };
+static const int DR[4] = { 0, 1, 0, -1 };
+
+const char* solverName(SolverAlgorithm algorithm) {
+    switch (algorithm) {
+    case SolverAlgorithm::Bfs:           return "bfs";
+    case SolverAlgorithm::AStar:         return "astar";
+    case SolverAlgorithm::Bidirectional: return "bidirectional";
+    case SolverAlgorithm::JumpPoint:     return "jps";
+    }
+    return "unknown";
+}
+
+bool parseSolver(const char* name, SolverAlgorithm& out) {
+    const SolverAlgorithm all[] = { SolverAlgorithm::Bfs, SolverAlgorithm::AStar,
+                                    SolverAlgorithm::Bidirectional, SolverAlgorithm::JumpPoint };
+    for (SolverAlgorithm a : all) {
+        if (std::strcmp(name, solverName(a)) == 0) {
+            out = a;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- Packed per-cell state ---
+static inline bool testBit(const std::vector<uint64_t>& bits, uint32_t cell) {
+    return (bits[cell >> 6] >> (cell & 63)) & 1u;
+}
+
+static inline void setBit(std::vector<uint64_t>& bits, uint32_t cell) {
+    bits[cell >> 6] |= uint64_t(1) << (cell & 63);
+}
+
+// Direction taken to reach the cell from its parent
+static inline void setParent(std::vector<uint64_t>& parents, uint32_t cell, int dir) {
+    uint64_t& word = parents[cell >> 5];
+    int shift = (cell & 31) * 2;
+    word = (word & ~(uint64_t(3) << shift)) | (uint64_t(dir) << shift);
+}
+
+static inline int getParent(const std::vector<uint64_t>& parents, uint32_t cell) {
+    return static_cast<int>((parents[cell >> 5] >> ((cell & 31) * 2)) & 3u);
+}
+
+// Append the cells from `cell` back to `origin`, both included
+static void traceBack(const std::vector<uint64_t>& parents, uint32_t cell, uint32_t origin,
+                      int width, std::vector<uint32_t>& out) {
+    const int32_t delta[4] = { 1, width, -1, -width };
+    out.push_back(cell);
+    while (cell != origin) {
+        cell -= delta[getParent(parents, cell)];
+        out.push_back(cell);
+    }
+}
+
+bool MazeSolver::prepare(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                         std::vector<uint32_t>& path, int sideCount) {
+    path.clear();
+    expanded = 0;
+    if (!m.inBounds(startRow, startCol) || m.isWall(startRow, startCol)) return false;
+    if (!m.inBounds(goalRow, goalCol) || m.isWall(goalRow, goalCol)) return false;
+
+    const std::size_t cells = static_cast<std::size_t>(m.width()) * m.height();
+    for (int s = 0; s < sideCount; ++s) {
+        sides[s].closed.assign((cells + 63) / 64, 0);
+        // Parents are only read for closed cells, so they never need clearing
+        sides[s].parents.resize((cells + 31) / 32);
+        sides[s].frontier.clear();
+        sides[s].next.clear();
+    }
+    return true;
+}
+
+bool MazeSolver::solve(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                       SolverAlgorithm algorithm, std::vector<uint32_t>& path) {
+    switch (algorithm) {
+    case SolverAlgorithm::Bfs:           return bfs(m, startRow, startCol, goalRow, goalCol, path);
+    case SolverAlgorithm::AStar:         return aStar(m, startRow, startCol, goalRow, goalCol, path);
+    case SolverAlgorithm::Bidirectional: return bidirectional(m, startRow, startCol, goalRow, goalCol, path);
+    case SolverAlgorithm::JumpPoint:     return jumpPoint(m, startRow, startCol, goalRow, goalCol, path);
+    }
+    return false;
+}
+
+// --- Breadth-first search ---
+bool MazeSolver::bfs(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                     std::vector<uint32_t>& path) {
+    if (!prepare(m, startRow, startCol, goalRow, goalCol, path, 1)) return false;
+
+    const int width = m.width();
+    const uint32_t start = static_cast<uint32_t>(startRow) * width + startCol;
+    const uint32_t goal = static_cast<uint32_t>(goalRow) * width + goalCol;
+    Side& side = sides[0];
+
+    setBit(side.closed, start);
+    side.frontier.push_back(start);
+    while (!side.frontier.empty()) {
+        for (uint32_t cell : side.frontier) {
+            ++expanded;
+            if (cell == goal) {
+                traceBack(side.parents, goal, start, width, path);
+                std::reverse(path.begin(), path.end());
+                return true;
+            }
+            int row = static_cast<int>(cell / width), col = static_cast<int>(cell % width);
+            for (int dir = 0; dir < 4; ++dir) {
+                int r = row + DR[dir], c = col + DC[dir];
+                if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+                uint32_t next = static_cast<uint32_t>(r) * width + c;
+                if (testBit(side.closed, next)) continue;
+                setBit(side.closed, next);
+                setParent(side.parents, next, dir);
+                side.next.push_back(next);
+            }
+        }
+        side.frontier.swap(side.next);
+        side.next.clear();
+    }
+    return false;
+}
+
+// --- A* ---
+// The heuristic is consistent, so the first time a cell is popped it has its
+// shortest distance: cells are closed (and their parent fixed) on pop, and
+// stale duplicate entries are skipped rather than decreased in place.
+static inline bool openBefore(uint32_t fa, uint32_t ga, uint32_t fb, uint32_t gb) {
+    return fa < fb || (fa == fb && ga > gb);
+}
+
+void MazeSolver::heapPush(const OpenEntry& entry) {
+    std::size_t i = heap.size();
+    heap.push_back(entry);
+    while (i > 0) {
+        std::size_t parent = (i - 1) / 2;
+        if (!openBefore(entry.f, entry.g, heap[parent].f, heap[parent].g)) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = entry;
+}
+
+MazeSolver::OpenEntry MazeSolver::heapPop() {
+    OpenEntry top = heap.front();
+    OpenEntry last = heap.back();
+    heap.pop_back();
+    const std::size_t n = heap.size();
+    if (n == 0) return top;
+
+    std::size_t i = 0;
+    for (;;) {
+        std::size_t child = 2 * i + 1;
+        if (child >= n) break;
+        if (child + 1 < n && openBefore(heap[child + 1].f, heap[child + 1].g, heap[child].f, heap[child].g))
+            ++child;
+        if (!openBefore(heap[child].f, heap[child].g, last.f, last.g)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = last;
+    return top;
+}
+
+bool MazeSolver::aStar(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                       std::vector<uint32_t>& path) {
+    if (!prepare(m, startRow, startCol, goalRow, goalCol, path, 1)) return false;
+
+    const int width = m.width();
+    const uint32_t start = static_cast<uint32_t>(startRow) * width + startCol;
+    const uint32_t goal = static_cast<uint32_t>(goalRow) * width + goalCol;
+    Side& side = sides[0];
+    auto heuristic = [&](int row, int col) {
+        return static_cast<uint32_t>(std::abs(row - goalRow) + std::abs(col - goalCol));
+    };
+
+    heap.clear();
+    heapPush({ heuristic(startRow, startCol), 0, start, 0, start });
+    while (!heap.empty()) {
+        OpenEntry entry = heapPop();
+        if (testBit(side.closed, entry.cell)) continue;
+        setBit(side.closed, entry.cell);
+        if (entry.cell != start) setParent(side.parents, entry.cell, static_cast<int>(entry.dir));
+        ++expanded;
+
+        if (entry.cell == goal) {
+            traceBack(side.parents, goal, start, width, path);
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int row = static_cast<int>(entry.cell / width), col = static_cast<int>(entry.cell % width);
+        for (int dir = 0; dir < 4; ++dir) {
+            int r = row + DR[dir], c = col + DC[dir];
+            if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+            uint32_t next = static_cast<uint32_t>(r) * width + c;
+            if (testBit(side.closed, next)) continue;
+            uint32_t g = entry.g + 1;
+            heapPush({ g + heuristic(r, c), g, next, static_cast<uint32_t>(dir), entry.cell });
+        }
+    }
+    return false;
+}
+
+// --- Bidirectional breadth-first search ---
+// Whole levels are expanded at a time and the searches stop at the first
+// edge joining them. Any shorter join would have involved a cell the other
+// side closed on an earlier level, and would have been found then.
+bool MazeSolver::bidirectional(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                               std::vector<uint32_t>& path) {
+    if (!prepare(m, startRow, startCol, goalRow, goalCol, path, 2)) return false;
+
+    const int width = m.width();
+    const uint32_t origins[2] = { static_cast<uint32_t>(startRow) * width + startCol,
+                                  static_cast<uint32_t>(goalRow) * width + goalCol };
+    if (origins[0] == origins[1]) {
+        expanded = 1;
+        path.push_back(origins[0]);
+        return true;
+    }
+    for (int s = 0; s < 2; ++s) {
+        setBit(sides[s].closed, origins[s]);
+        sides[s].frontier.push_back(origins[s]);
+    }
+
+    while (!sides[0].frontier.empty() && !sides[1].frontier.empty()) {
+        const int s = sides[0].frontier.size() <= sides[1].frontier.size() ? 0 : 1;
+        Side& side = sides[s];
+        const Side& other = sides[1 - s];
+
+        for (uint32_t cell : side.frontier) {
+            ++expanded;
+            int row = static_cast<int>(cell / width), col = static_cast<int>(cell % width);
+            for (int dir = 0; dir < 4; ++dir) {
+                int r = row + DR[dir], c = col + DC[dir];
+                if (!m.inBounds(r, c) || m.isWall(r, c)) continue;
+                uint32_t next = static_cast<uint32_t>(r) * width + c;
+
+                if (testBit(other.closed, next)) {
+                    // Start half reversed, then the goal half already runs forward
+                    uint32_t fromStart = s == 0 ? cell : next, fromGoal = s == 0 ? next : cell;
+                    traceBack(sides[0].parents, fromStart, origins[0], width, path);
+                    std::reverse(path.begin(), path.end());
+                    traceBack(sides[1].parents, fromGoal, origins[1], width, path);
+                    return true;
+                }
+                if (testBit(side.closed, next)) continue;
+                setBit(side.closed, next);
+                setParent(side.parents, next, dir);
+                side.next.push_back(next);
+            }
+        }
+        side.frontier.swap(side.next);
+        side.next.clear();
+    }
+    return false;
+}
+
+// --- Jump point search ---
+// Canonical paths on a 4-connected grid move vertically, peeling off
+// horizontal runs at every step, and a horizontal run only turns where a
+// wall beside it has just ended (a forced neighbour). Vertical runs
+// therefore stop wherever a horizontal scan from them finds a jump point.
+static inline bool openCell(const Maze& m, int row, int col) {
+    return m.inBounds(row, col) && !m.isWall(row, col);
+}
+
+int64_t MazeSolver::jumpHorizontal(const Maze& m, int row, int col, int dir, int goalRow, int goalCol) const {
+    const int dc = DC[dir];
+    for (;;) {
+        col += dc;
+        if (!openCell(m, row, col)) return -1;
+        if (row == goalRow && col == goalCol) break;
+        if ((openCell(m, row - 1, col) && !openCell(m, row - 1, col - dc)) ||
+            (openCell(m, row + 1, col) && !openCell(m, row + 1, col - dc)))
+            break;
+    }
+    return static_cast<int64_t>(row) * m.width() + col;
+}
+
+int64_t MazeSolver::jump(const Maze& m, int row, int col, int dir, int goalRow, int goalCol) const {
+    if (DR[dir] == 0) return jumpHorizontal(m, row, col, dir, goalRow, goalCol);
+    const int dr = DR[dir];
+    for (;;) {
+        row += dr;
+        if (!openCell(m, row, col)) return -1;
+        if (row == goalRow && col == goalCol) break;
+        if (jumpHorizontal(m, row, col, 0, goalRow, goalCol) >= 0 ||
+            jumpHorizontal(m, row, col, 2, goalRow, goalCol) >= 0)
+            break;
+    }
+    return static_cast<int64_t>(row) * m.width() + col;
+}
+
+bool MazeSolver::jumpPoint(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                           std::vector<uint32_t>& path) {
+    if (!prepare(m, startRow, startCol, goalRow, goalCol, path, 1)) return false;
+
+    const int width = m.width();
+    const uint32_t start = static_cast<uint32_t>(startRow) * width + startCol;
+    const uint32_t goal = static_cast<uint32_t>(goalRow) * width + goalCol;
+    Side& side = sides[0];
+    auto heuristic = [&](int row, int col) {
+        return static_cast<uint32_t>(std::abs(row - goalRow) + std::abs(col - goalCol));
+    };
+
+    // The start expands in every direction; its dir is never read
+    const uint32_t ANY = 4;
+    heap.clear();
+    jumpParents.clear();
+    heapPush({ heuristic(startRow, startCol), 0, start, ANY, start });
+    while (!heap.empty()) {
+        OpenEntry entry = heapPop();
+        if (testBit(side.closed, entry.cell)) continue;
+        setBit(side.closed, entry.cell);
+        jumpParents.emplace_back(entry.cell, entry.parent);
+        ++expanded;
+
+        if (entry.cell == goal) {
+            // Jump points are joined by straight runs; fill in the cells between
+            std::sort(jumpParents.begin(), jumpParents.end());
+            uint32_t cell = goal;
+            path.push_back(cell);
+            while (cell != start) {
+                auto link = std::lower_bound(jumpParents.begin(), jumpParents.end(),
+                                             std::make_pair(cell, uint32_t(0)));
+                const uint32_t parent = link->second;
+                const int32_t step = (parent / width == cell / width) ? 1 : width;
+                while (cell != parent) {
+                    cell = cell > parent ? cell - step : cell + step;
+                    path.push_back(cell);
+                }
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        int row = static_cast<int>(entry.cell / width), col = static_cast<int>(entry.cell % width);
+        int dirs[4], count = 0;
+        if (entry.dir == ANY) {
+            for (int dir = 0; dir < 4; ++dir) dirs[count++] = dir;
+        } else if (DR[entry.dir] != 0) {
+            // Vertical: keep going, and branch both ways horizontally
+            dirs[count++] = static_cast<int>(entry.dir);
+            dirs[count++] = 0;
+            dirs[count++] = 2;
+        } else {
+            // Horizontal: keep going, and turn only into forced neighbours
+            const int dc = DC[entry.dir];
+            dirs[count++] = static_cast<int>(entry.dir);
+            if (openCell(m, row - 1, col) && !openCell(m, row - 1, col - dc)) dirs[count++] = 3;
+            if (openCell(m, row + 1, col) && !openCell(m, row + 1, col - dc)) dirs[count++] = 1;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            int64_t found = jump(m, row, col, dirs[i], goalRow, goalCol);
+            if (found < 0) continue;
+            uint32_t next = static_cast<uint32_t>(found);
+            if (testBit(side.closed, next)) continue;
+            int r = static_cast<int>(next / width), c = static_cast<int>(next % width);
+            uint32_t g = entry.g + static_cast<uint32_t>(std::abs(r - row) + std::abs(c - col));
+            heapPush({ g + heuristic(r, c), g, next, static_cast<uint32_t>(dirs[i]), entry.cell });
+        }
+    }
+    return false;
+}
+
+std::size_t MazeSolver::memoryBytes() const {
+    std::size_t bytes = heap.capacity() * sizeof(OpenEntry);
+    bytes += jumpParents.capacity() * sizeof(jumpParents[0]);
+    for (const Side& side : sides) {
+        bytes += (side.closed.capacity() + side.parents.capacity()) * sizeof(uint64_t);
+        bytes += (side.frontier.capacity() + side.next.capacity()) * sizeof(uint32_t);
+    }
+    return bytes;
+}
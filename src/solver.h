@@ -0,0 +1,84 @@
+#ifndef SOLVER_H
+#define SOLVER_H
+
+#include "maze_grid.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+enum class SolverAlgorithm { Bfs, AStar, Bidirectional, JumpPoint };
+
+const char* solverName(SolverAlgorithm algorithm);
+// Accepts the names returned by solverName(); returns false if unknown
+bool parseSolver(const char* name, SolverAlgorithm& out);
+
+// Shortest-path search over the open cells of a maze, moving between the
+// four edge neighbours at unit cost. Paths are linear cell indices
+// (row * width + col), start first and goal last.
+//
+// Every search finds a shortest path. Per cell they keep one closed bit
+// and a 2-bit parent direction, packed into 64-bit words, so an
+// 8192x8192 grid costs 24 MB of scratch (twice that for bidirectional).
+// Jump point search also lists the parent of each closed jump point.
+// The scratch is owned by the solver and reused, so keep one around
+// instead of constructing a new solver for every query.
+class MazeSolver {
+public:
+    // Returns false, leaving path empty, if either end is a wall, outside
+    // the grid, or the two are not connected
+    bool solve(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+               SolverAlgorithm algorithm, std::vector<uint32_t>& path);
+
+    // Breadth-first, one level at a time
+    bool bfs(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+             std::vector<uint32_t>& path);
+    // A* with the Manhattan distance, which never overestimates on a 4-connected grid
+    bool aStar(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+               std::vector<uint32_t>& path);
+    // Breadth-first from both ends, always growing the smaller frontier
+    bool bidirectional(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                       std::vector<uint32_t>& path);
+
+    // Jump point search: A* over the cells where a shortest path can turn.
+    // Straight runs through open rooms and corridors are scanned without
+    // being queued, so it expands far fewer cells than aStar() away from
+    // narrow perfect-maze passages.
+    bool jumpPoint(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                   std::vector<uint32_t>& path);
+
+    // Cells taken off the open set by the last search
+    std::size_t nodesExpanded() const { return expanded; }
+    std::size_t memoryBytes() const;
+
+private:
+    // One search direction: closed bits, parent directions and the frontier
+    struct Side {
+        std::vector<uint64_t> closed;
+        std::vector<uint64_t> parents; // 32 cells per word, 2 bits each
+        std::vector<uint32_t> frontier, next;
+    };
+    // A* open-set entry; ordered by f, then deeper g first. parent is only
+    // read by jump point search, where it can be many cells away.
+    struct OpenEntry {
+        uint32_t f, g, cell, dir, parent;
+    };
+
+    bool prepare(const Maze& m, int startRow, int startCol, int goalRow, int goalCol,
+                 std::vector<uint32_t>& path, int sides);
+
+    // Walk from a jump point in direction dir; returns the next jump point
+    // or -1 if the run hits a wall first
+    int64_t jump(const Maze& m, int row, int col, int dir, int goalRow, int goalCol) const;
+    int64_t jumpHorizontal(const Maze& m, int row, int col, int dir, int goalRow, int goalCol) const;
+
+    void heapPush(const OpenEntry& entry);
+    OpenEntry heapPop();
+
+    Side sides[2];
+    std::vector<OpenEntry> heap;
+    std::vector<std::pair<uint32_t, uint32_t>> jumpParents; // (cell, parent) of closed jump points
+    std::size_t expanded = 0;
+};
+
+#endif
@@ -0,0 +1,55 @@
+#include "visibility.h"
+#include <algorithm>
+#include <cmath>
+
+void GridVisibility::mark(const Maze& m, int row, int col) {
+    uint8_t& cell = marks[(row - originRow) * size + (col - originCol)];
+    if (cell) return;
+    cell = 1;
+    if (m.isWall(row, col)) ++wallsSeen;
+    else ++openSeen;
+}
+
+void GridVisibility::compute(const Maze& m, float spacing, float camX, float camZ,
+                             float dirX, float dirZ, float fov, float maxDistance) {
+    // Grid space: x = column, y = row (world -Z)
+    const float gx = camX / spacing, gy = -camZ / spacing;
+    const float maxCells = maxDistance / spacing;
+    const int radius = static_cast<int>(std::ceil(maxCells)) + 1;
+    const int camCol = static_cast<int>(std::floor(gx)), camRow = static_cast<int>(std::floor(gy));
+
+    size = 2 * radius + 1;
+    originRow = camRow - radius;
+    originCol = camCol - radius;
+    marks.assign(static_cast<std::size_t>(size) * size, 0);
+    wallsSeen = openSeen = 0;
+
+    // Two rays per cell width at the far end, so no cell slips between rays
+    const int rayCount = std::max(16, static_cast<int>(std::ceil(fov * maxCells * 2.0f)));
+    const float heading = std::atan2(-dirZ, dirX);
+
+    mark(m, camRow, camCol);
+    for (int r = 0; r < rayCount; ++r) {
+        float angle = heading - fov * 0.5f + fov * (r + 0.5f) / rayCount;
+        float rx = std::cos(angle), ry = std::sin(angle);
+
+        walkGridRay(m, gx, gy, rx, ry, maxCells, [&](int row, int col) { mark(m, row, col); });
+    }
+}
+
+bool GridVisibility::isVisible(int row, int col) const {
+    int r = row - originRow, c = col - originCol;
+    if (r < 0 || r >= size || c < 0 || c >= size) return false;
+    return marks[r * size + c] != 0;
+}
+
+bool GridVisibility::anyVisibleIn(int row0, int col0, int rows, int cols) const {
+    int r0 = std::max(row0 - originRow, 0), r1 = std::min(row0 + rows - originRow, size);
+    int c0 = std::max(col0 - originCol, 0), c1 = std::min(col0 + cols - originCol, size);
+    for (int r = r0; r < r1; ++r) {
+        const uint8_t* line = marks.data() + r * size;
+        for (int c = c0; c < c1; ++c)
+            if (line[c]) return true;
+    }
+    return false;
+}
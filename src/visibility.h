@@ -0,0 +1,77 @@
+#ifndef VISIBILITY_H
+#define VISIBILITY_H
+
+#include "maze_grid.h"
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Walk a 2D ray through the grid (Amanatides & Woo), starting at grid
+// position (gx, gy) = (column, row) in direction (rx, ry). visit(row, col)
+// is called for every cell entered, up to maxCells cells away; the walk
+// stops after the first wall cell, which is still visited.
+template <class Visit>
+void walkGridRay(const Maze& m, float gx, float gy, float rx, float ry, float maxCells, Visit visit) {
+    int col = static_cast<int>(std::floor(gx)), row = static_cast<int>(std::floor(gy));
+    int stepX = rx >= 0.0f ? 1 : -1, stepY = ry >= 0.0f ? 1 : -1;
+    float deltaX = rx != 0.0f ? std::fabs(1.0f / rx) : 1e30f;
+    float deltaY = ry != 0.0f ? std::fabs(1.0f / ry) : 1e30f;
+    float sideX = (rx >= 0.0f ? (col + 1 - gx) : (gx - col)) * deltaX;
+    float sideY = (ry >= 0.0f ? (row + 1 - gy) : (gy - row)) * deltaY;
+
+    while (true) {
+        float t;
+        if (sideX < sideY) {
+            t = sideX;
+            sideX += deltaX;
+            col += stepX;
+        } else {
+            t = sideY;
+            sideY += deltaY;
+            row += stepY;
+        }
+        if (t > maxCells) return;
+        visit(row, col);
+        if (m.isWall(row, col)) return;
+    }
+}
+
+// Which cells the renderer may need this frame
+class CellVisibility {
+public:
+    virtual ~CellVisibility() = default;
+    // True if any cell in the given block may be visible
+    virtual bool anyVisibleIn(int row0, int col0, int rows, int cols) const = 0;
+    // Wall cells in the set, for the culling counters
+    virtual int visibleWallCells() const = 0;
+};
+
+// Cells actually seen from the camera, found by casting 2D rays through the
+// grid with a DDA walk. Walls are taller than the eye height and the camera
+// never pitches, so a wall cell fully blocks everything behind it.
+// Marks live in a small window around the camera (radius = view distance),
+// so the per-frame cost does not depend on the size of the maze.
+class GridVisibility : public CellVisibility {
+public:
+    // dirX/dirZ is the horizontal view direction, fov the horizontal field of
+    // view in radians; rays stop after maxDistance world units.
+    void compute(const Maze& m, float spacing, float camX, float camZ,
+                 float dirX, float dirZ, float fov, float maxDistance);
+
+    bool isVisible(int row, int col) const;
+    // True if any cell in the given block was reached by a ray
+    bool anyVisibleIn(int row0, int col0, int rows, int cols) const override;
+
+    int visibleWallCells() const override { return wallsSeen; }
+    int visibleOpenCells() const { return openSeen; }
+
+private:
+    void mark(const Maze& m, int row, int col);
+
+    int originRow = 0, originCol = 0; // grid cell at window index (0, 0)
+    int size = 0;                     // window is size x size cells
+    std::vector<uint8_t> marks;
+    int wallsSeen = 0, openSeen = 0;
+};
+
+#endif
@@ -0,0 +1,104 @@
+#include "wall_mesh.h"
+#include <glm/glm.hpp>
+
+// A cell counts as open if it is a corridor or lies outside the grid
+static bool isOpen(const Maze& m, int i, int j) {
+    return !m.isWall(i, j);
+}
+
+// Two triangles for a quad given in counter-clockwise order seen from outside
+static void appendQuad(std::vector<float>& out, const glm::vec3& a, const glm::vec3& b,
+                       const glm::vec3& c, const glm::vec3& d, const glm::vec3& n) {
+    const glm::vec3 corners[6] = { a, b, c, c, d, a };
+    for (const glm::vec3& p : corners) {
+        out.push_back(p.x); out.push_back(p.y); out.push_back(p.z);
+        out.push_back(n.x); out.push_back(n.y); out.push_back(n.z);
+    }
+}
+
+// --- Static wall mesh ---
+// Only faces that border an open cell are emitted, and co-planar runs of
+// exposed faces are merged into a single long quad (greedy meshing).
+// Bottom faces sit on the floor and are never visible, so they are skipped.
+// Neighbours are read from the full grid, so a region's border faces match
+// what the whole-maze mesh would contain.
+void buildWallMesh(const Maze& m, float spacing, int row0, int col0, int rowCount, int colCount,
+                   std::vector<float>& out) {
+    const int row1 = row0 + rowCount, col1 = col0 + colCount;
+    const float h = spacing * WALL_HEIGHT_SCALE;
+
+    // Side faces facing +Z / -Z: runs along a row
+    for (int i = row0; i < row1; ++i) {
+        for (int side = 0; side < 2; ++side) {
+            int ni = side == 0 ? i - 1 : i + 1;
+            float z = side == 0 ? -i * spacing : -(i + 1) * spacing;
+            int j = col0;
+            while (j < col1) {
+                if (!m.isWall(i, j) || !isOpen(m, ni, j)) { ++j; continue; }
+                int start = j;
+                while (j < col1 && m.isWall(i, j) && isOpen(m, ni, j)) ++j;
+                float x0 = start * spacing, x1 = j * spacing;
+                if (side == 0)
+                    appendQuad(out, glm::vec3(x0, 0, z), glm::vec3(x1, 0, z),
+                               glm::vec3(x1, h, z), glm::vec3(x0, h, z), glm::vec3(0, 0, 1));
+                else
+                    appendQuad(out, glm::vec3(x1, 0, z), glm::vec3(x0, 0, z),
+                               glm::vec3(x0, h, z), glm::vec3(x1, h, z), glm::vec3(0, 0, -1));
+            }
+        }
+    }
+
+    // Side faces facing +X / -X: runs along a column
+    for (int j = col0; j < col1; ++j) {
+        for (int side = 0; side < 2; ++side) {
+            int nj = side == 0 ? j + 1 : j - 1;
+            float x = side == 0 ? (j + 1) * spacing : j * spacing;
+            int i = row0;
+            while (i < row1) {
+                if (!m.isWall(i, j) || !isOpen(m, i, nj)) { ++i; continue; }
+                int start = i;
+                while (i < row1 && m.isWall(i, j) && isOpen(m, i, nj)) ++i;
+                float z0 = -i * spacing, z1 = -start * spacing;
+                if (side == 0)
+                    appendQuad(out, glm::vec3(x, 0, z1), glm::vec3(x, 0, z0),
+                               glm::vec3(x, h, z0), glm::vec3(x, h, z1), glm::vec3(1, 0, 0));
+                else
+                    appendQuad(out, glm::vec3(x, 0, z0), glm::vec3(x, 0, z1),
+                               glm::vec3(x, h, z1), glm::vec3(x, h, z0), glm::vec3(-1, 0, 0));
+            }
+        }
+    }
+
+    // Top faces: grow maximal rectangles over wall cells
+    std::vector<bool> used(static_cast<std::size_t>(rowCount) * colCount, false);
+    auto isUsed = [&](int i, int j) { return used[(i - row0) * colCount + (j - col0)]; };
+    for (int i = row0; i < row1; ++i) {
+        for (int j = col0; j < col1; ++j) {
+            if (!m.isWall(i, j) || isUsed(i, j)) continue;
+            int w = 1;
+            while (j + w < col1 && m.isWall(i, j + w) && !isUsed(i, j + w)) ++w;
+            int rows = 1;
+            for (bool grow = true; grow && i + rows < row1; ) {
+                for (int k = 0; k < w; ++k) {
+                    if (!m.isWall(i + rows, j + k) || isUsed(i + rows, j + k)) {
+                        grow = false;
+                        break;
+                    }
+                }
+                if (grow) ++rows;
+            }
+            for (int r = 0; r < rows; ++r)
+                for (int k = 0; k < w; ++k)
+                    used[(i + r - row0) * colCount + (j + k - col0)] = true;
+
+            float x0 = j * spacing, x1 = (j + w) * spacing;
+            float z0 = -(i + rows) * spacing, z1 = -i * spacing;
+            appendQuad(out, glm::vec3(x0, h, z1), glm::vec3(x1, h, z1),
+                       glm::vec3(x1, h, z0), glm::vec3(x0, h, z0), glm::vec3(0, 1, 0));
+        }
+    }
+}
+
+void buildWallMesh(const Maze& m, float spacing, std::vector<float>& out) {
+    buildWallMesh(m, spacing, 0, 0, m.height(), m.width(), out);
+}
@@ -0,0 +1,18 @@
+#ifndef WALL_MESH_H
+#define WALL_MESH_H
+
+#include "maze_grid.h"
+#include <vector>
+
+// Walls are extruded this many cell widths upwards
+const float WALL_HEIGHT_SCALE = 10.0f;
+
+// Bake every wall of the maze into a world-space triangle list of
+// interleaved position/normal floats (6 per vertex).
+void buildWallMesh(const Maze& m, float spacing, std::vector<float>& out);
+// Same, restricted to the walls inside rows [row0, row0 + rowCount) and
+// columns [col0, col0 + colCount)
+void buildWallMesh(const Maze& m, float spacing, int row0, int col0, int rowCount, int colCount,
+                   std::vector<float>& out);
+
+#endif
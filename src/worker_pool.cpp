@@ -0,0 +1,60 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(int threads) {
+    if (threads <= 0)
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    for (int t = 1; t < threads; ++t)
+        workers.emplace_back(&WorkerPool::workerLoop, this, t);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : workers)
+        t.join();
+}
+
+// Worker t takes slot t of every job; the calling thread takes slot 0
+void WorkerPool::workerLoop(int index) {
+    uint64_t seen = 0;
+    for (;;) {
+        Call call;
+        void* context;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || job != seen; });
+            if (stopping) return;
+            seen = job;
+            call = jobCall;
+            context = jobContext;
+        }
+
+        call(context, index);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--pending == 0) done.notify_one();
+    }
+}
+
+void WorkerPool::dispatch(Call call, void* context) {
+    if (workers.empty()) {
+        call(context, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobCall = call;
+        jobContext = context;
+        pending = static_cast<int>(workers.size());
+        ++job;
+    }
+    wake.notify_all();
+    call(context, 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [&] { return pending == 0; });
+}
@@ -0,0 +1,47 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Threads started once and reused for every job, so a per-frame or
+// per-tick job pays a wake-up rather than a thread start. run(job) calls
+// job(t) once for every slot t in [0, size()), slot 0 on the calling
+// thread, and returns when all of them have finished.
+class WorkerPool {
+public:
+    // threads = 0 uses every hardware thread
+    explicit WorkerPool(int threads = 0);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    template <class Job>
+    void run(Job&& job) {
+        using JobType = typename std::remove_reference<Job>::type;
+        dispatch([](void* context, int slot) { (*static_cast<JobType*>(context))(slot); }, &job);
+    }
+
+private:
+    using Call = void (*)(void* context, int slot);
+    void dispatch(Call call, void* context);
+    void workerLoop(int index);
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake, done;
+    // Job in flight, read by the workers
+    Call jobCall = nullptr;
+    void* jobContext = nullptr;
+    uint64_t job = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+#endif